@@ -0,0 +1,141 @@
+// Standalone benchmark of parallel_for, parallel_reduce and parallel_sort, measuring how each scales with threads
+// Builds without the rest of the engine, see the makefile and readme alongside it
+
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include <functional>
+
+#include <threading/parallel.h>
+#include <memory/frame_arena.h>
+
+namespace
+{
+    struct Timings
+    {
+        double for_ms = 0;
+        double reduce_ms = 0;
+        double sort_ms = 0;
+    };
+
+    template <typename F>
+    double measure_ms(F&& f)
+    {
+        const auto start = std::chrono::high_resolution_clock::now();
+        f();
+        const auto end = std::chrono::high_resolution_clock::now();
+
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    Timings measure(size_t num_threads, const std::vector<float>& items, std::vector<float>& results, int runs)
+    {
+        // The thread running the benchmark executes chunks too, so needs one fewer worker
+        threading::JobSystem job_system(num_threads - 1);
+        const threading::ParallelOptions options = {
+            .name = "parallel benchmark",
+            .job_system = &job_system
+        };
+
+        Timings timings;
+        for (int run = 0; run < runs; run++)
+        {
+            timings.for_ms += measure_ms([&]
+            {
+                threading::parallel_for_chunks(items.size(), [&](size_t begin, size_t end)
+                {
+                    for (size_t i = begin; i < end; i++)
+                    {
+                        results[i] = std::sin(items[i]) * std::cos(items[i]);
+                    }
+                }, options);
+            });
+
+            double sum = 0;
+            timings.reduce_ms += measure_ms([&]
+            {
+                sum = threading::parallel_reduce(
+                    items, 0.0,
+                    [](float item) { return std::sqrt(static_cast<double>(item)); },
+                    std::plus(),
+                    options
+                );
+            });
+
+            results = items;
+            timings.sort_ms += measure_ms([&]
+            {
+                threading::parallel_sort(results, std::ranges::less(), options);
+            });
+
+            if (!std::ranges::is_sorted(results) || sum <= 0)
+            {
+                std::fprintf(stderr, "Parallel benchmark produced incorrect results\n");
+                std::exit(1);
+            }
+
+            // Chunk results come from the frame arena, which the engine would reset at the end of each frame
+            memory::FrameArena::get().reset();
+        }
+
+        timings.for_ms /= runs;
+        timings.reduce_ms /= runs;
+        timings.sort_ms /= runs;
+
+        return timings;
+    }
+}
+
+// Usage: parallel_benchmark [items] [runs] [max threads]
+int main(int argc, char** argv)
+{
+    const size_t item_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    const int runs = argc > 2 ? std::atoi(argv[2]) : 10;
+    const size_t max_threads = argc > 3
+        ? std::strtoull(argv[3], nullptr, 10)
+        : std::max(1u, std::thread::hardware_concurrency());
+
+    std::printf(
+        "Parallel benchmark with %zu items over %d runs, up to %zu threads on %u hardware threads\n",
+        item_count, runs, max_threads, std::thread::hardware_concurrency()
+    );
+
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> distribution(0.0f, 1000.0f);
+
+    std::vector<float> items(item_count);
+    for (float& item : items)
+    {
+        item = distribution(rng);
+    }
+
+    std::vector<float> results(item_count);
+
+    std::printf("| Threads | for (ms) | Speedup | reduce (ms) | Speedup | sort (ms) | Speedup |\n");
+    std::printf("|--------:|---------:|--------:|------------:|--------:|----------:|--------:|\n");
+
+    Timings single_threaded;
+    for (size_t num_threads = 1; num_threads <= max_threads; num_threads *= 2)
+    {
+        const Timings timings = measure(num_threads, items, results, runs);
+        if (num_threads == 1)
+        {
+            single_threaded = timings;
+        }
+
+        std::printf(
+            "| %7zu | %8.3f | %6.2fx | %11.3f | %6.2fx | %9.3f | %6.2fx |\n",
+            num_threads,
+            timings.for_ms, single_threaded.for_ms / timings.for_ms,
+            timings.reduce_ms, single_threaded.reduce_ms / timings.reduce_ms,
+            timings.sort_ms, single_threaded.sort_ms / timings.sort_ms
+        );
+    }
+
+    return 0;
+}
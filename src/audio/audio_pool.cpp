@@ -1,5 +1,7 @@
 #include "audio_pool.h"
 
+#include <memory/pool_allocator.h>
+
 using namespace audio;
 
 void AudioPool::play(const peng::shared_ref<const AudioClip>& clip)
@@ -31,7 +33,7 @@ peng::shared_ref<AudioSource> AudioPool::get_free_source()
     }
 
     // Create a new source otherwise
-    peng::shared_ref<AudioSource> source = peng::make_shared<AudioSource>();
+    peng::shared_ref<AudioSource> source = memory::make_pooled<AudioSource>();
     _busy_sources.emplace_back(source);
 
     return source;
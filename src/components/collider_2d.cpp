@@ -1,18 +1,21 @@
 #include "collider_2d.h"
 
+#include <utils/vectools.h>
+#include <memory/frame_arena.h>
+
 IMPLEMENT_COMPONENT(components::Collider2D);
 
 using namespace components;
 using namespace math;
 
-std::vector<peng::weak_ptr<Collider2D>> Collider2D::_active_colliders;
+std::vector<Handle<Collider2D>> Collider2D::_active_colliders;
 
 Collider2D::Collider2D()
 	: Component(TickGroup::physics)
 	, triggers_enabled(false)
 { }
 
-const std::vector<peng::weak_ptr<Collider2D>>& Collider2D::active_colliders()
+const std::vector<Handle<Collider2D>>& Collider2D::active_colliders()
 {
 	return _active_colliders;
 }
@@ -21,14 +24,14 @@ void Collider2D::post_create()
 {
 	Component::post_create();
 
-	_active_colliders.push_back(weak_this());
+	_active_colliders.push_back(handle());
 }
 
 void Collider2D::pre_destroy()
 {
 	Component::pre_destroy();
 
-	vectools::remove(_active_colliders, weak_this());
+	vectools::remove(_active_colliders, handle());
 }
 
 void Collider2D::tick(float delta_time)
@@ -38,12 +41,20 @@ void Collider2D::tick(float delta_time)
 	if (triggers_enabled)
 	{
 		const physics::AABB aabb = bounding_box();
-		std::vector<peng::weak_ptr<Collider2D>> old_overlaps = std::move(_current_overlaps);
+
+		// The old overlaps are moved into the frame arena so that the current overlaps keep their capacity
+		std::pmr::vector<Handle<Collider2D>> old_overlaps(
+			std::make_move_iterator(_current_overlaps.begin()),
+			std::make_move_iterator(_current_overlaps.end()),
+			memory::frame_resource()
+		);
+
+		_current_overlaps.clear();
 
 		// Check all other colliders for new overlaps
-		for (peng::weak_ptr<Collider2D> other : active_colliders())
+		for (const Handle<Collider2D>& other : active_colliders())
 		{
-			if (this != other.lock().get())
+			if (this != other.get())
 			{
 				const physics::AABB other_aabb = other->bounding_box();
 				if (aabb.overlaps(other_aabb))
@@ -69,7 +80,7 @@ void Collider2D::tick(float delta_time)
 		}
 
 		// Anything remaining in old_overlaps list is gone and needs an exit event
-		for (peng::weak_ptr<Collider2D> collider : old_overlaps)
+		for (const Handle<Collider2D>& collider : old_overlaps)
 		{
 			_on_trigger_exit(collider);
 		}
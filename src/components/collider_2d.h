@@ -11,14 +11,14 @@ namespace components
 	{
 		DECLARE_COMPONENT(Collider2D);
 
-		DEFINE_EVENT(on_trigger_enter, const peng::weak_ptr<Collider2D>&)
-		DEFINE_EVENT(on_trigger_stay, const peng::weak_ptr<Collider2D>&)
-		DEFINE_EVENT(on_trigger_exit, const peng::weak_ptr<Collider2D>&)
+		DEFINE_EVENT(on_trigger_enter, const Handle<Collider2D>&)
+		DEFINE_EVENT(on_trigger_stay, const Handle<Collider2D>&)
+		DEFINE_EVENT(on_trigger_exit, const Handle<Collider2D>&)
 
 	public:
 		Collider2D();
 
-		static const std::vector<peng::weak_ptr<Collider2D>>& active_colliders();
+		static const std::vector<Handle<Collider2D>>& active_colliders();
 
 		void post_create() override;
 		void pre_destroy() override;
@@ -30,8 +30,8 @@ namespace components
 		bool triggers_enabled;
 
 	private:
-		static std::vector<peng::weak_ptr<Collider2D>> _active_colliders;
+		static std::vector<Handle<Collider2D>> _active_colliders;
 
-		std::vector<peng::weak_ptr<Collider2D>> _current_overlaps;
+		std::vector<Handle<Collider2D>> _current_overlaps;
 	};
 }
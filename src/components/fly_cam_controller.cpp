@@ -36,7 +36,7 @@ void FlyCamController::tick(float delta_time)
 		return;
 	}
 
-	const peng::shared_ref<Camera> camera = Camera::current().lock().to_shared_ref();
+	Camera* camera = Camera::current().get();
 	Transform& camera_transform = camera->local_transform();
 
 	const Vector3f fly_forwards = camera_transform.local_forwards();
@@ -1,8 +1,11 @@
 #include "mesh_renderer.h"
 
+#include <utility>
+
 #include <core/logger.h>
 #include <core/asset.h>
 #include <core/serialized_member.h>
+#include <core/tick_access.h>
 #include <entities/camera.h>
 #include <entities/point_light.h>
 #include <entities/spot_light.h>
@@ -11,6 +14,7 @@
 #include <rendering/primitives.h>
 #include <rendering/material.h>
 #include <rendering/render_queue.h>
+#include <memory/frame_arena.h>
 #include <utils/utils.h>
 #include <math/math.h>
 
@@ -50,49 +54,98 @@ MeshRenderer::MeshRenderer(
 	)
 { }
 
-// TODO: majorly needs breaking up into some sub functions
 void MeshRenderer::tick(float delta_time)
 {
 	Component::tick(delta_time);
 
+	const Vector3f view_pos = Camera::current()
+		? Camera::current()->world_position()
+		: Vector3f::zero();
+
+	const Matrix4x4f view_matrix = Camera::current()
+		? Camera::current()->view_matrix()
+		: Matrix4x4f::identity();
+
+	render(view_pos, view_matrix);
+}
+
+const TickAccess* MeshRenderer::tick_access() const noexcept
+{
+	// Renderers only read transforms, lights and the camera, and snapshot their uniforms into the draws they enqueue
+	// The render queue accepts commands from any thread
+	static const TickAccess access = TickAccess("MeshRenderer")
+		.reads<Entity>()
+		.independent();
+
+	return &access;
+}
+
+void MeshRenderer::tick_all(std::span<MeshRenderer> components, float)
+{
+	// Camera state is shared by every renderer so only needs resolving once per batch
+	const Vector3f view_pos = Camera::current()
+		? Camera::current()->world_position()
+		: Vector3f::zero();
+
+	const Matrix4x4f view_matrix = Camera::current()
+		? Camera::current()->view_matrix()
+		: Matrix4x4f::identity();
+
+	for (MeshRenderer& mesh_renderer : components)
+	{
+		mesh_renderer.render(view_pos, view_matrix);
+	}
+}
+
+// TODO: majorly needs breaking up into some sub functions
+void MeshRenderer::render(const Vector3f& view_pos, const Matrix4x4f& view_matrix)
+{
 	// Nothing to render without a material or mesh
 	if (!(_material && _mesh))
 	{
 		return;
 	}
 
-	const Vector3f view_pos = Camera::current()
-		? Camera::current()->world_position()
-		: Vector3f::zero();
+	// Uniforms are snapshotted into the draw rather than set on the shared material, so that the next frame ticking
+	// while this one is submitted cannot change what it draws with
+	DrawUniforms uniforms;
+	uniforms.reserve(4 + 5 * _max_point_lights + 7 * _max_spot_lights + 4 * _max_directional_lights);
+
+	const auto add_uniform = [&](GLint location, const auto& value)
+	{
+		if (location >= 0)
+		{
+			uniforms.emplace_back(location, value);
+		}
+	};
 
 	if (_cached_uniforms.model_matrix >= 0)
 	{
-		const Matrix4x4f model_matrix = owner().transform_matrix();
-		_material->set_parameter(_cached_uniforms.model_matrix, model_matrix);
+		const Matrix4x4f& model_matrix = owner().transform_matrix();
+		add_uniform(_cached_uniforms.model_matrix, model_matrix);
 
 		if (_cached_uniforms.normal_matrix >= 0)
 		{
-			const Matrix3x3f normal_matrix = Matrix3x3f(model_matrix)
-				.inverse()
+			// The upper 3x3 of the cached inverse model matrix is the inverse of the model's upper 3x3
+			const Matrix3x3f normal_matrix = Matrix3x3f(owner().transform_matrix_inv())
 				.transposed();
 
-			_material->set_parameter(_cached_uniforms.normal_matrix, normal_matrix);
+			add_uniform(_cached_uniforms.normal_matrix, normal_matrix);
 		}
 	}
 
 	if (_cached_uniforms.view_matrix >= 0)
 	{
-		const Matrix4x4f view_matrix = Camera::current() ? Camera::current()->view_matrix() : Matrix4x4f::identity();
-		_material->set_parameter(_cached_uniforms.view_matrix, view_matrix);
+		add_uniform(_cached_uniforms.view_matrix, view_matrix);
 	}
 
 	if (_uses_lighting)
 	{
-		_material->try_set_parameter(_cached_uniforms.view_pos, view_pos);
+		add_uniform(_cached_uniforms.view_pos, view_pos);
 
 		// Point lights
 		{
-			const std::vector<peng::shared_ref<const PointLight>> point_lights = get_relevant_point_lights();
+			const std::pmr::vector<peng::shared_ref<const PointLight>> point_lights = get_relevant_point_lights();
 			for (int32_t i = 0; i < _max_point_lights; i++)
 			{
 				const Vector3f light_pos = i < point_lights.size()
@@ -104,17 +157,17 @@ void MeshRenderer::tick(float delta_time)
 					: PointLight::LightData();
 
 				const PointLightUniformSet& uniform_set = _cached_uniforms.point_lights[i];
-				_material->try_set_parameter(uniform_set.pos, light_pos);
-				_material->try_set_parameter(uniform_set.color, light_data.color);
-				_material->try_set_parameter(uniform_set.ambient, light_data.ambient);
-				_material->try_set_parameter(uniform_set.range, light_data.range);
-				_material->try_set_parameter(uniform_set.max_strength, 1.0f);
+				add_uniform(uniform_set.pos, light_pos);
+				add_uniform(uniform_set.color, light_data.color);
+				add_uniform(uniform_set.ambient, light_data.ambient);
+				add_uniform(uniform_set.range, light_data.range);
+				add_uniform(uniform_set.max_strength, 1.0f);
 			}
 		}
 
 		// Spot lights
 		{
-			const std::vector<peng::shared_ref<const SpotLight>> spot_lights = get_relevant_spot_lights();
+			const std::pmr::vector<peng::shared_ref<const SpotLight>> spot_lights = get_relevant_spot_lights();
 			for (int32_t i = 0; i < _max_spot_lights; i++)
 			{
 				const Vector3f light_pos = i < spot_lights.size()
@@ -134,13 +187,13 @@ void MeshRenderer::tick(float delta_time)
 				const float penumbra_cos = std::cos(math::degs_to_rads(light_data.penumbra));
 
 				const SpotLightUniformSet& uniform_set = _cached_uniforms.spot_lights[i];
-				_material->try_set_parameter(uniform_set.pos, light_pos);
-				_material->try_set_parameter(uniform_set.dir, light_dir);
-				_material->try_set_parameter(uniform_set.color, light_data.color);
-				_material->try_set_parameter(uniform_set.ambient, light_data.ambient);
-				_material->try_set_parameter(uniform_set.range, light_data.range);
-				_material->try_set_parameter(uniform_set.umbra_cos, umbra_cos);
-				_material->try_set_parameter(uniform_set.penumbra_cos, penumbra_cos);
+				add_uniform(uniform_set.pos, light_pos);
+				add_uniform(uniform_set.dir, light_dir);
+				add_uniform(uniform_set.color, light_data.color);
+				add_uniform(uniform_set.ambient, light_data.ambient);
+				add_uniform(uniform_set.range, light_data.range);
+				add_uniform(uniform_set.umbra_cos, umbra_cos);
+				add_uniform(uniform_set.penumbra_cos, penumbra_cos);
 			}
 		}
 
@@ -149,13 +202,14 @@ void MeshRenderer::tick(float delta_time)
 			// TODO: support multiple directional lights
 			for (int32_t i = 0; i < _max_directional_lights; i++)
 			{
-				peng::weak_ptr<DirectionalLight> directional_light = i == 0
+				const Handle<DirectionalLight> directional_light = i == 0
 					? DirectionalLight::current()
-					: peng::weak_ptr<DirectionalLight>{};
+					: Handle<DirectionalLight>{};
 
 				// TODO: this doesn't work if light has spatial parents that rotate it
+				// Read through the const transform, as mutable access would dirty the light's matrices from every renderer
 				const Vector3f light_dir = directional_light
-					? -directional_light->local_transform().local_up()
+					? -std::as_const(*directional_light).local_transform().local_up()
 					: -Vector3f::up();
 
 				const DirectionalLight::LightData light_data = directional_light
@@ -163,10 +217,10 @@ void MeshRenderer::tick(float delta_time)
 					: DirectionalLight::LightData();
 
 				const DirectionalLightUniformSet& uniform_set = _cached_uniforms.directional_lights[i];
-				_material->try_set_parameter(uniform_set.dir, light_dir);
-				_material->try_set_parameter(uniform_set.color, light_data.color);
-				_material->try_set_parameter(uniform_set.ambient, light_data.ambient);
-				_material->try_set_parameter(uniform_set.intensity, light_data.intensity);
+				add_uniform(uniform_set.dir, light_dir);
+				add_uniform(uniform_set.color, light_data.color);
+				add_uniform(uniform_set.ambient, light_data.ambient);
+				add_uniform(uniform_set.intensity, light_data.intensity);
 			}
 		}
 	}
@@ -180,7 +234,8 @@ void MeshRenderer::tick(float delta_time)
 		.mesh = _mesh,
 		.material = _material,
 		.order = order,
-		.instance_count = 1
+		.instance_count = 1,
+		.uniforms = std::move(uniforms)
 	});
 }
 
@@ -316,23 +371,25 @@ void MeshRenderer::cache_uniforms()
 	}
 }
 
-std::vector<peng::shared_ref<const PointLight>> MeshRenderer::get_relevant_point_lights()
+std::pmr::vector<peng::shared_ref<const PointLight>> MeshRenderer::get_relevant_point_lights()
 {
 	struct Consideration
 	{
-		peng::shared_ref<const PointLight> light;
+		Handle<const PointLight> light;
 		float relevance;
 	};
 
 	// Start with all active point lights
-	const std::vector<peng::weak_ptr<PointLight>> active_lights = PointLight::active_lights();
+	const std::vector<Handle<PointLight>>& active_lights = PointLight::active_lights();
 
 	// Calculate the relative strength for each light to the origin of this object
 	// Drop any invalid or disabled lights
 	// TODO: consider relative strength to bounding box instead
 	// TODO: skip considerations if we don't need to do them
-	std::vector<Consideration> considerations;
-	for (const peng::weak_ptr<PointLight>& light : active_lights)
+	std::pmr::vector<Consideration> considerations(memory::frame_resource());
+	considerations.reserve(active_lights.size());
+
+	for (const Handle<PointLight>& light : active_lights)
 	{
 		if (light && light->active_in_hierarchy())
 		{
@@ -341,7 +398,7 @@ std::vector<peng::shared_ref<const PointLight>> MeshRenderer::get_relevant_point
 			const float relative_strength = light_intensity_sqr / light_dist_sqr;
 
 			considerations.emplace_back(Consideration{
-				.light = light.lock().to_shared_ref(),
+				.light = light,
 				.relevance = relative_strength
 			});
 		}
@@ -354,24 +411,30 @@ std::vector<peng::shared_ref<const PointLight>> MeshRenderer::get_relevant_point
 	});
 
 	// Only pick the most relevant ones
-	std::vector<peng::shared_ref<const PointLight>> relevant_lights;
-	for (size_t i = 0; i < std::min<size_t>(considerations.size(), _max_point_lights); i++)
+	const size_t num_relevant = std::min<size_t>(considerations.size(), _max_point_lights);
+
+	std::pmr::vector<peng::shared_ref<const PointLight>> relevant_lights(memory::frame_resource());
+	relevant_lights.reserve(num_relevant);
+
+	for (size_t i = 0; i < num_relevant; i++)
 	{
-		relevant_lights.push_back(considerations[i].light);
+		relevant_lights.push_back(considerations[i].light.to_shared_ref());
 	}
 
 	return relevant_lights;
 }
 
 // TODO: this just returns the first n lights - make a proper implementation
-std::vector<peng::shared_ref<const SpotLight>> MeshRenderer::get_relevant_spot_lights()
+std::pmr::vector<peng::shared_ref<const SpotLight>> MeshRenderer::get_relevant_spot_lights()
 {
-	std::vector<peng::shared_ref<const SpotLight>> relevant_lights;
-	for (peng::weak_ptr<SpotLight> spot_light : SpotLight::active_lights())
+	std::pmr::vector<peng::shared_ref<const SpotLight>> relevant_lights(memory::frame_resource());
+	relevant_lights.reserve(_max_spot_lights);
+
+	for (const Handle<SpotLight>& spot_light : SpotLight::active_lights())
 	{
 	    if (spot_light)
 	    {
-			relevant_lights.push_back(spot_light.lock().to_shared_ref());
+			relevant_lights.push_back(spot_light.to_shared_ref());
 			if (relevant_lights.size() >= _max_spot_lights)
 			{
 			    break;
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <memory_resource>
+
 #include <core/component.h>
 
 namespace entities
@@ -21,6 +23,7 @@ namespace components
 	class MeshRenderer final : public Component
 	{
 		DECLARE_COMPONENT(MeshRenderer);
+		DECLARE_BATCHED_TICK(MeshRenderer);
 
 	public:
 		MeshRenderer();
@@ -37,6 +40,7 @@ namespace components
 
 		void tick(float delta_time) override;
 		void post_create() override;
+		[[nodiscard]] const TickAccess* tick_access() const noexcept override;
 
 		void set_mesh(const peng::shared_ptr<const rendering::Mesh>& mesh);
 		void set_material(const peng::shared_ptr<rendering::Material>& material);
@@ -45,9 +49,12 @@ namespace components
 		[[nodiscard]] const peng::shared_ptr<rendering::Material>& material() const noexcept { return _material; }
 
 	private:
+		void render(const math::Vector3f& view_pos, const math::Matrix4x4f& view_matrix);
 		void cache_uniforms();
-		std::vector<peng::shared_ref<const entities::PointLight>> get_relevant_point_lights();
-		std::vector<peng::shared_ref<const entities::SpotLight>> get_relevant_spot_lights();
+
+		// Relevant lights only last for the frame so are allocated from the frame arena
+		std::pmr::vector<peng::shared_ref<const entities::PointLight>> get_relevant_point_lights();
+		std::pmr::vector<peng::shared_ref<const entities::SpotLight>> get_relevant_spot_lights();
 
 		peng::shared_ptr<const rendering::Mesh> _mesh;
 		peng::shared_ptr<rendering::Material> _material;
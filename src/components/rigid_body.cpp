@@ -1,6 +1,7 @@
 #include "rigid_body.h"
 
 #include <core/serialized_member.h>
+#include <core/tick_access.h>
 
 IMPLEMENT_COMPONENT(components::RigidBody);
 
@@ -19,3 +20,18 @@ void RigidBody::tick(float delta_time)
 
 	owner().local_transform().position += velocity * delta_time;
 }
+
+void RigidBody::tick_all(std::span<RigidBody> components, float delta_time)
+{
+	for (RigidBody& rigid_body : components)
+	{
+		rigid_body.owner().local_transform().position += rigid_body.velocity * delta_time;
+	}
+}
+
+const TickAccess* RigidBody::tick_access() const noexcept
+{
+	// Each body only reads its own velocity and moves its own entity
+	static const TickAccess access = TickAccess("RigidBody").independent();
+	return &access;
+}
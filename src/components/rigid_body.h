@@ -8,11 +8,13 @@ namespace components
 	class RigidBody final : public Component
 	{
 		DECLARE_COMPONENT(RigidBody);
+		DECLARE_BATCHED_TICK(RigidBody);
 
 	public:
 		RigidBody();
 
 		void tick(float delta_time) override;
+		[[nodiscard]] const TickAccess* tick_access() const noexcept override;
 
 		math::Vector3f velocity;
 	};
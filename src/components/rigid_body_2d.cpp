@@ -1,6 +1,7 @@
 #include "rigid_body_2d.h"
 
 #include <core/serialized_member.h>
+#include <core/tick_access.h>
 
 IMPLEMENT_COMPONENT(components::RigidBody2D);
 
@@ -19,3 +20,18 @@ void RigidBody2D::tick(float delta_time)
 
 	owner().local_transform().position += Vector3f(velocity * delta_time, 0);
 }
+
+void RigidBody2D::tick_all(std::span<RigidBody2D> components, float delta_time)
+{
+	for (RigidBody2D& rigid_body : components)
+	{
+		rigid_body.owner().local_transform().position += Vector3f(rigid_body.velocity * delta_time, 0);
+	}
+}
+
+const TickAccess* RigidBody2D::tick_access() const noexcept
+{
+	// Each body only reads its own velocity and moves its own entity
+	static const TickAccess access = TickAccess("RigidBody2D").independent();
+	return &access;
+}
@@ -8,11 +8,13 @@ namespace components
 	class RigidBody2D final : public Component
 	{
 		DECLARE_COMPONENT(RigidBody2D);
+		DECLARE_BATCHED_TICK(RigidBody2D);
 
 	public:
 		RigidBody2D();
 
 		void tick(float delta_time) override;
+		[[nodiscard]] const TickAccess* tick_access() const noexcept override;
 
 		math::Vector2f velocity;
 	};
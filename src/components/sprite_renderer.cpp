@@ -2,6 +2,7 @@
 
 #include <core/serialized_member.h>
 #include <core/asset.h>
+#include <core/tick_access.h>
 #include <entities/camera.h>
 #include <rendering/primitives.h>
 #include <rendering/material.h>
@@ -37,8 +38,36 @@ void SpriteRenderer::tick(float delta_time)
 		return;
 	}
 
-	const Matrix4x4f model_matrix = owner().transform_matrix();
+	enqueue_draw(Camera::current()->view_matrix());
+}
+
+const TickAccess* SpriteRenderer::tick_access() const noexcept
+{
+	// Renderers only read transforms and the camera, and the render queue accepts commands from any thread
+	static const TickAccess access = TickAccess("SpriteRenderer")
+		.reads<Entity>()
+		.independent();
+
+	return &access;
+}
+
+void SpriteRenderer::tick_all(std::span<SpriteRenderer> components, float)
+{
+	if (!Camera::current())
+	{
+		return;
+	}
+
 	const Matrix4x4f view_matrix = Camera::current()->view_matrix();
+	for (const SpriteRenderer& sprite_renderer : components)
+	{
+		sprite_renderer.enqueue_draw(view_matrix);
+	}
+}
+
+void SpriteRenderer::enqueue_draw(const Matrix4x4f& view_matrix) const
+{
+	const Matrix4x4f& model_matrix = owner().transform_matrix();
 	const Matrix4x4f mvp_matrix = view_matrix * model_matrix;
 
 	RenderQueue::get().enqueue_command(SpriteDrawCall{
@@ -13,12 +13,14 @@ namespace components
 	class SpriteRenderer final : public Component
 	{
 		DECLARE_COMPONENT(SpriteRenderer);
+		DECLARE_BATCHED_TICK(SpriteRenderer);
 
 	public:
 		SpriteRenderer();
 		explicit SpriteRenderer(const peng::shared_ref<const rendering::Sprite>& sprite);
 
 		void tick(float delta_time) override;
+		[[nodiscard]] const TickAccess* tick_access() const noexcept override;
 
 		[[nodiscard]] peng::shared_ref<const rendering::Sprite>& sprite() noexcept { return _sprite; }
 		[[nodiscard]] const peng::shared_ref<const rendering::Sprite>& sprite() const noexcept { return _sprite; }
@@ -27,6 +29,8 @@ namespace components
 		[[nodiscard]] const math::Vector4f& color() const noexcept { return _color; }
 
 	private:
+		void enqueue_draw(const math::Matrix4x4f& view_matrix) const;
+
 		peng::shared_ref<const rendering::Sprite> _sprite;
 		math::Vector4f _color;
 	};
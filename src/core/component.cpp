@@ -1,18 +1,53 @@
 #include "component.h"
 
+#include <limits>
+
+#include "entity.h"
 #include "logger.h"
 
 IMPLEMENT_COMPONENT(Component);
 
 Component::Component(TickGroup tick_group)
 	: _tick_group(tick_group)
+	, _handle_id(HandleRegistry<Component>::get().allocate(this))
+	, _type_id(0)
+	, _type_index_slot(-1)
+	, _storage_slot(std::numeric_limits<uint32_t>::max())
 { }
 
+Component::~Component()
+{
+	HandleRegistry<Component>::get().release(_handle_id);
+}
+
 TickGroup Component::tick_group() const noexcept
 {
 	return _tick_group;
 }
 
+void Component::set_tick_rate(const TickRate& tick_rate)
+{
+	// Only moving between the throttled and regular lists requires a rebuild
+	const bool was_throttled = _tick_rate.throttled();
+	_tick_rate = tick_rate;
+
+	if (_owner.valid() && was_throttled != _tick_rate.throttled())
+	{
+		owner().invalidate_tickables();
+	}
+}
+
+ScriptId Component::start_script(Script&& script)
+{
+	// Components live as long as their owner, so their scripts are owned by it
+	return owner().start_script(std::move(script));
+}
+
+void Component::stop_script(ScriptId id)
+{
+	owner().stop_script(id);
+}
+
 Entity& Component::owner() noexcept
 {
 	const Component* const_this = this;
@@ -21,22 +56,22 @@ Entity& Component::owner() noexcept
 
 const Entity& Component::owner() const noexcept
 {
-	const peng::shared_ptr<Entity> owner_locked = _owner.lock();
+	const Entity* owner = _owner.get();
 
 	// If the owner is no longer valid then something has gone wrong
 	// as the component should never outlive the owner
-	check(owner_locked);
-	return *owner_locked.get();
+	check(owner);
+	return *owner;
 }
 
 void Component::set_owner(peng::shared_ref<Entity>&& entity)
 {
-	if (_owner.valid() && _owner != entity)
+	if (_owner.valid() && _owner.get() != entity.get())
 	{
 		Logger::error("Component already has an owner");
 	}
 	else
 	{
-		_owner = entity;
+		_owner = EntityHandle(entity);
 	}
 }
@@ -1,12 +1,22 @@
 #pragma once
 
+#include <memory>
+
 #include <memory/weak_ptr.h>
 
 #include "tickable.h"
+#include "tick_rate.h"
+#include "script.h"
 #include "serializable.h"
+#include "component_batch.h"
+#include "component_type_id.h"
 #include "component_definition.h"
 
 class Entity;
+class EntitySubsystem;
+
+template <typename T>
+class ComponentStorage;
 
 class Component :
     public ITickable,
@@ -14,26 +24,55 @@ class Component :
     public std::enable_shared_from_this<Component>
 {
 	friend Entity;
+	friend EntitySubsystem;
+
+	template <typename T>
+	friend class ComponentStorage;
 
 	DECLARE_COMPONENT(Component);
 
 public:
+	using handle_base = Component;
+
 	explicit Component(TickGroup tick_group = TickGroup::standard);
 	Component(const Component&) = delete;
 	Component(Component&&) = delete;
+	~Component() override;
 
 	void tick([[maybe_unused]] float delta_time) override { }
 	[[nodiscard]] TickGroup tick_group() const noexcept override;
 
+	// Throttled components are ticked less often than every frame, see TickRate
+	// Batched components are always ticked every frame as part of their batch
+	void set_tick_rate(const TickRate& tick_rate);
+	[[nodiscard]] const TickRate& tick_rate() const noexcept { return _tick_rate; }
+
+	// Starts a coroutine script owned by the component, see Entity::start_script
+	ScriptId start_script(Script&& script);
+	void stop_script(ScriptId id);
+
 	virtual void post_create() { }
 	virtual void pre_destroy() { }
 
+	// Overridden by DECLARE_BATCHED_TICK for types that tick all their instances together
+	[[nodiscard]] virtual bool batched_tick() const noexcept { return false; }
+	[[nodiscard]] virtual std::unique_ptr<IComponentBatch> create_tick_batch() const { return nullptr; }
+
 	[[nodiscard]] Entity& owner() noexcept;
 	[[nodiscard]] const Entity& owner() const noexcept;
+	[[nodiscard]] const HandleId& handle_id() const noexcept { return _handle_id; }
+	[[nodiscard]] ComponentTypeId type_id() const noexcept { return _type_id; }
 
 private:
 	void set_owner(peng::shared_ref<Entity>&& entity);
 
 	TickGroup _tick_group;
-	peng::weak_ptr<Entity> _owner;
+	TickRate _tick_rate;
+	TickRateState _tick_rate_state;
+	HandleId _handle_id;
+	EntityHandle _owner;
+	ComponentTypeId _type_id;
+	int32_t _type_index_slot;
+	// Slot within the type's ComponentStorage, for components with batched ticks
+	uint32_t _storage_slot;
 };
\ No newline at end of file
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <typeinfo>
+#include <algorithm>
+
+#include <threading/parallel.h>
+
+#include "entity_command.h"
+#include "component_storage.h"
+
+class Component;
+
+template <typename T>
+concept batch_tickable = requires(std::span<T> components, float delta_time)
+{
+	T::tick_all(components, delta_time);
+};
+
+// Every active component of a single type within a tick group, ticked through the type's tick_all rather than a
+// virtual tick per component
+// Batched components live in their type's ComponentStorage, which the batch walks in memory order
+class IComponentBatch
+{
+public:
+	virtual ~IComponentBatch() = default;
+
+	virtual void add(Component& component) = 0;
+	virtual void clear() noexcept = 0;
+	// Commands recorded by each component are ordered from order_base by its storage slot
+	virtual void tick_all(float delta_time, bool parallel, uint64_t order_base) = 0;
+
+	[[nodiscard]] virtual bool accepts(const Component& component) const noexcept = 0;
+	[[nodiscard]] virtual size_t size() const noexcept = 0;
+	// The span of command orders used from order_base
+	[[nodiscard]] virtual size_t num_slots() const noexcept = 0;
+};
+
+template <batch_tickable T>
+class ComponentBatch final : public IComponentBatch
+{
+public:
+	// Number of slots handed to each worker when the batch is ticked in a parallel tick group
+	static constexpr size_t chunk_size = ComponentStorage<T>::chunk_size;
+
+	void add(Component& component) override
+	{
+		const uint32_t slot = ComponentStorage<T>::slot_of(static_cast<const T&>(component));
+		check(slot != ComponentStorage<T>::invalid_slot);
+
+		if (slot >= _ticking.size())
+		{
+			_ticking.resize(slot + 1, false);
+		}
+
+		check(!_ticking[slot]);
+		_ticking[slot] = true;
+		_size++;
+	}
+
+	void clear() noexcept override
+	{
+		_ticking.clear();
+		_size = 0;
+	}
+
+	void tick_all(float delta_time, bool parallel, uint64_t order_base) override
+	{
+		if (!parallel || _ticking.size() <= chunk_size)
+		{
+			tick_slots(0, _ticking.size(), delta_time, order_base);
+			return;
+		}
+
+		threading::parallel_for_chunks(_ticking.size(), [&](size_t begin, size_t end)
+		{
+			tick_slots(begin, end, delta_time, order_base);
+		}, {
+			.grain_size = chunk_size,
+			.name = "component batch"
+		});
+	}
+
+	[[nodiscard]] bool accepts(const Component& component) const noexcept override
+	{
+		return typeid(component) == typeid(T);
+	}
+
+	[[nodiscard]] size_t size() const noexcept override
+	{
+		return _size;
+	}
+
+	[[nodiscard]] size_t num_slots() const noexcept override
+	{
+		return _ticking.size();
+	}
+
+private:
+	// Ticks each run of neighbouring active slots within [begin, end) through a single tick_all
+	void tick_slots(size_t begin, size_t end, float delta_time, uint64_t order_base) const
+	{
+		const ComponentStorage<T>& storage = ComponentStorage<T>::get();
+
+		for (size_t slot = begin; slot < end;)
+		{
+			if (!_ticking[slot])
+			{
+				slot++;
+				continue;
+			}
+
+			// Chunks of storage aren't adjacent in memory, so runs stop at the end of a chunk
+			const size_t chunk_end = std::min(end, (slot / chunk_size + 1) * chunk_size);
+
+			size_t run_end = slot + 1;
+			while (run_end < chunk_end && _ticking[run_end])
+			{
+				run_end++;
+			}
+
+			command_order::set(order_base + slot);
+			T::tick_all(storage.slots(static_cast<uint32_t>(slot), static_cast<uint32_t>(run_end)), delta_time);
+
+			slot = run_end;
+		}
+	}
+
+	// Whether each storage slot holds a component in this batch
+	std::vector<uint8_t> _ticking;
+	size_t _size = 0;
+};
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <type_traits>
+
+#include "handle.h"
 #include "detail/component_definition_bootstrap.h"
 
 #define DECLARE_COMPONENT(ComponentType) \
@@ -18,8 +21,41 @@ public: \
 	{ \
 		return peng::weak_ptr<const ComponentType>(std::static_pointer_cast<const ComponentType>(shared_from_this())); \
 	} \
+	\
+	[[nodiscard]] Handle<ComponentType> handle() noexcept \
+	{ \
+		return Handle<ComponentType>(handle_id()); \
+	} \
+	\
+	[[nodiscard]] Handle<const ComponentType> handle() const noexcept \
+	{ \
+		return Handle<const ComponentType>(handle_id()); \
+	} \
+	\
+	/* Components whose type doesn't override Component::tick are never ticked */ \
+	[[nodiscard]] virtual bool overrides_tick() const noexcept \
+	{ \
+		return !std::is_same_v<decltype(&ComponentType::tick), void (Component::*)(float)>; \
+	} \
 private: \
 	static core::detail::ComponentDefinitionBootstrap<ComponentType> _component_bootstrap
 
 #define IMPLEMENT_COMPONENT(ComponentType) \
 	core::detail::ComponentDefinitionBootstrap<ComponentType> ComponentType::_component_bootstrap(#ComponentType)
+
+// Opts a component type into batched ticking, where the entity subsystem ticks every active instance with a single call to
+// static void tick_all(std::span<ComponentType> components, float delta_time)
+// Instances of batched types are stored contiguously in ComponentStorage, so the span covers them in place
+#define DECLARE_BATCHED_TICK(ComponentType) \
+public: \
+	[[nodiscard]] bool batched_tick() const noexcept override \
+	{ \
+		return true; \
+	} \
+	\
+	[[nodiscard]] std::unique_ptr<IComponentBatch> create_tick_batch() const override \
+	{ \
+		return std::make_unique<ComponentBatch<ComponentType>>(); \
+	} \
+	\
+	static void tick_all(std::span<ComponentType> components, float delta_time)
\ No newline at end of file
@@ -59,3 +59,13 @@ peng::weak_ptr<Component> ComponentFactory::load_component(const Archive& archiv
 
 	return component;
 }
+
+std::unique_ptr<Serializable> ComponentFactory::create_prototype(const peng::shared_ref<const ReflectedType>& component_type) const
+{
+	if (!_prototype_factory.has_factory(component_type))
+	{
+		return nullptr;
+	}
+
+	return _prototype_factory.construct_item(component_type);
+}
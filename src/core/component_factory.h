@@ -1,5 +1,7 @@
 #pragma once
 
+#include <memory>
+
 #include <memory/weak_ptr.h>
 
 #include "entity.h"
@@ -29,8 +31,13 @@ public:
 	// Returns nullptr if the load failed
 	peng::weak_ptr<Component> load_component(const Archive& archive, const peng::weak_ptr<Entity>& entity);
 
+	// Constructs a component of the given type without an owner, for compiling archives against
+	// Returns nullptr if the type has no viable constructors
+	[[nodiscard]] std::unique_ptr<Serializable> create_prototype(const peng::shared_ref<const ReflectedType>& component_type) const;
+
 private:
 	ItemFactory<peng::weak_ptr<Component>, const peng::weak_ptr<Entity>&> _factory;
+	ItemFactory<std::unique_ptr<Serializable>> _prototype_factory;
 };
 
 template <std::derived_from<Component> T>
@@ -46,6 +53,10 @@ void ComponentFactory::register_component()
 		};
 
 		_factory.register_factory(component_type, component_constructor);
+		_prototype_factory.register_factory(component_type, []() -> std::unique_ptr<Serializable>
+		{
+			return std::make_unique<T>();
+		});
 	}
 	else
 	{
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <new>
+#include <span>
+#include <array>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+#include <memory/shared_ref.h>
+#include <memory/pool_allocator.h>
+#include <utils/check.h>
+
+class Component;
+
+// Contiguous storage for every instance of a component type, used by types with batched ticks
+// Instances are constructed in place within fixed size chunks, so a batch iterates over them in memory order rather
+// than following a pointer to a separate allocation per component
+// Chunks are never moved or released, so components stay put for their whole lifetime and may be freed from any thread
+template <typename T>
+class ComponentStorage
+{
+public:
+	static constexpr uint32_t chunk_size = 1024;
+	static constexpr uint32_t max_chunks = 4096;
+	static constexpr uint32_t invalid_slot = std::numeric_limits<uint32_t>::max();
+
+	ComponentStorage(const ComponentStorage&) = delete;
+	ComponentStorage(ComponentStorage&&) = delete;
+
+	// Storage is leaked like block pools, so that it outlives components released during static destruction
+	[[nodiscard]] static ComponentStorage& get()
+	{
+		static ComponentStorage& storage = *new ComponentStorage();
+		return storage;
+	}
+
+	// Constructs a component in a free slot, with its shared control block allocated from a pool
+	template <typename...Args>
+	[[nodiscard]] peng::shared_ref<T> make(Args&&...args)
+	{
+		const uint32_t slot = allocate_slot();
+		T* component = new (slot_address(slot)) T(std::forward<Args>(args)...);
+		static_cast<Component*>(component)->_storage_slot = slot;
+
+		return peng::shared_ref<T>(std::shared_ptr<T>(component, Deleter(), memory::PoolAllocator<T, ComponentStorage>()));
+	}
+
+	// The live components in the slots [begin, end), which must lie within a single chunk
+	[[nodiscard]] std::span<T> slots(uint32_t begin, uint32_t end) const noexcept
+	{
+		check(begin < end);
+		check(begin / chunk_size == (end - 1) / chunk_size);
+
+		return std::span<T>(std::launder(reinterpret_cast<T*>(slot_address(begin))), end - begin);
+	}
+
+	// One past the highest slot ever allocated
+	[[nodiscard]] uint32_t num_slots() const noexcept
+	{
+		std::lock_guard lock(_mutex);
+		return _num_slots;
+	}
+
+	[[nodiscard]] static uint32_t slot_of(const T& component) noexcept
+	{
+		return static_cast<const Component&>(component)._storage_slot;
+	}
+
+private:
+	struct alignas(T) Slot
+	{
+		std::byte bytes[sizeof(T)];
+	};
+
+	static_assert(sizeof(Slot) == sizeof(T), "Slots must be laid out exactly like an array of T");
+
+	struct Deleter
+	{
+		void operator()(T* component) const noexcept
+		{
+			const uint32_t slot = slot_of(*component);
+			component->~T();
+			get().release_slot(slot);
+		}
+	};
+
+	ComponentStorage() = default;
+
+	[[nodiscard]] uint32_t allocate_slot()
+	{
+		std::lock_guard lock(_mutex);
+
+		if (!_free_slots.empty())
+		{
+			const uint32_t slot = _free_slots.back();
+			_free_slots.pop_back();
+			return slot;
+		}
+
+		const uint32_t chunk = _num_slots / chunk_size;
+		check(chunk < max_chunks);
+
+		if (!_chunks[chunk])
+		{
+			_chunks[chunk] = std::make_unique<Slot[]>(chunk_size);
+		}
+
+		return _num_slots++;
+	}
+
+	void release_slot(uint32_t slot) noexcept
+	{
+		std::lock_guard lock(_mutex);
+		_free_slots.push_back(slot);
+	}
+
+	[[nodiscard]] std::byte* slot_address(uint32_t slot) const noexcept
+	{
+		return _chunks[slot / chunk_size][slot % chunk_size].bytes;
+	}
+
+	mutable std::mutex _mutex;
+	std::array<std::unique_ptr<Slot[]>, max_chunks> _chunks;
+	std::vector<uint32_t> _free_slots;
+	uint32_t _num_slots = 0;
+};
@@ -0,0 +1,41 @@
+#include "component_type_id.h"
+
+#include <mutex>
+#include <unordered_map>
+
+namespace core::detail
+{
+	struct ComponentTypeIds
+	{
+		std::mutex mutex;
+		std::unordered_map<const std::type_info*, ComponentTypeId> ids;
+	};
+
+	ComponentTypeIds& get_component_type_ids()
+	{
+		static ComponentTypeIds type_ids;
+		return type_ids;
+	}
+}
+
+ComponentTypeId core::detail::allocate_component_type_id(const std::type_info& type_info)
+{
+	ComponentTypeIds& type_ids = get_component_type_ids();
+	std::lock_guard lock(type_ids.mutex);
+
+	const auto [it, inserted] = type_ids.ids.try_emplace(&type_info, static_cast<ComponentTypeId>(type_ids.ids.size()));
+	return it->second;
+}
+
+std::optional<ComponentTypeId> find_component_type_id(const std::type_info& type_info)
+{
+	core::detail::ComponentTypeIds& type_ids = core::detail::get_component_type_ids();
+	std::lock_guard lock(type_ids.mutex);
+
+	if (const auto it = type_ids.ids.find(&type_info); it != type_ids.ids.end())
+	{
+		return it->second;
+	}
+
+	return std::nullopt;
+}
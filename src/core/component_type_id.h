@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <typeinfo>
+#include <type_traits>
+
+// Dense integer IDs for component types, assigned when the type is registered or its ID is first requested
+using ComponentTypeId = uint32_t;
+
+namespace core::detail
+{
+	[[nodiscard]] ComponentTypeId allocate_component_type_id(const std::type_info& type_info);
+}
+
+// Finds the ID of a component type from its type info, for lookups by reflected type
+[[nodiscard]] std::optional<ComponentTypeId> find_component_type_id(const std::type_info& type_info);
+
+template <typename T>
+[[nodiscard]] ComponentTypeId component_type_id()
+{
+	static const ComponentTypeId type_id = core::detail::allocate_component_type_id(typeid(std::remove_cv_t<T>));
+	return type_id;
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <core/component_factory.h>
+#include <core/component_type_id.h>
 
 #include "reflection_bootstrap.h"
 
@@ -22,6 +23,9 @@ namespace core::detail
 	ComponentDefinitionBootstrap<T>::ComponentDefinitionBootstrap(const std::string& type_name)
 		: _reflection_bootstrap(type_name)
 	{
+		// Assigning IDs up front keeps the IDs of registered types small, so they fit in each entity's component mask
+		[[maybe_unused]] const ComponentTypeId type_id = component_type_id<T>();
+
 		if constexpr (!std::is_abstract_v<T>)
 		{
 			ComponentFactory::get().register_component<T>();
@@ -1,6 +1,9 @@
 #include "entity.h"
 
+#include <bit>
+
 #include <utils/utils.h>
+#include <utils/vectools.h>
 
 #include "serialized_member.h"
 #include "entity_subsystem.h"
@@ -13,11 +16,34 @@ Entity::Entity(std::string&& name, TickGroup tick_group)
 	, _tick_group(tick_group)
     , _constructed(false)
 	, _created(false)
+	, _tickables_registered(false)
+	, _destroying(false)
+	, _parallel_post_create(false)
 	, _active_self(true)
 	, _active_hierarchy(true)
+	, _state(EntityState::invalid)
+	, _name_index_slot(-1)
+	, _type_index_slot(-1)
+	, _creation_index(0)
+	, _handle_id(HandleRegistry<Entity>::get().allocate(this))
 	, _parent_relationship(EntityRelationship::full)
+	, _local_matrix_dirty(true)
+	, _transform_queued(false)
+	, _spatial_depth(0)
+	, _transform_pass(0)
+	, _component_mask()
 {
 	SERIALIZED_MEMBER(_local_transform, "transform");
+
+	add_deserializer([this](const Archive&)
+	{
+		invalidate_local_transform();
+	});
+}
+
+Entity::~Entity()
+{
+	HandleRegistry<Entity>::get().release(_handle_id);
 }
 
 Entity::Entity(const std::string& name, TickGroup tick_group)
@@ -34,6 +60,18 @@ TickGroup Entity::tick_group() const noexcept
 	return _tick_group;
 }
 
+void Entity::set_tick_rate(const TickRate& tick_rate)
+{
+	// Only moving between the throttled and regular lists requires a rebuild
+	const bool was_throttled = _tick_rate.throttled();
+	_tick_rate = tick_rate;
+
+	if (was_throttled != _tick_rate.throttled())
+	{
+		invalidate_tickables();
+	}
+}
+
 void Entity::post_create()
 {
 	// TODO: entities should receive post_enable() when created
@@ -59,9 +97,10 @@ void Entity::pre_destroy()
 		component->pre_destroy();
 	}
 
-	if (_parent)
+	// No need to unlink from a parent that is being destroyed alongside this entity
+	if (_parent && !_parent->_destroying)
 	{
-		vectools::remove(_parent->_children, weak_this());
+		vectools::remove(_parent->_children, handle());
 	}
 }
 
@@ -76,7 +115,24 @@ void Entity::set_active(bool active)
 	propagate_active_change(true);
 }
 
-void Entity::set_parent(const peng::weak_ptr<Entity>& parent, EntityRelationship relationship)
+void Entity::set_name(const std::string& name)
+{
+	if (name == _name)
+	{
+		return;
+	}
+
+	if (_name_index_slot >= 0)
+	{
+		EntitySubsystem::get().rename_entity(*this, name);
+	}
+	else
+	{
+		_name = name;
+	}
+}
+
+void Entity::set_parent(const EntityHandle& parent, EntityRelationship relationship)
 {
 	const bool was_active_hierarchy = _active_hierarchy;
 
@@ -87,21 +143,28 @@ void Entity::set_parent(const peng::weak_ptr<Entity>& parent, EntityRelationship
 
 	if (_parent.valid())
 	{
-		vectools::remove(_parent->_children, weak_this());
+		vectools::remove(_parent->_children, handle());
 		_active_hierarchy = _active_self;
 	}
 
 	_parent = parent;
 	_parent_relationship = relationship;
+	update_spatial_depth();
+	invalidate_transform();
 
 	if (_parent.valid())
 	{
-		_parent->_children.push_back(weak_this());
+		_parent->_children.push_back(handle());
 		_active_hierarchy = has_activity_parent()
 			? _active_self && _parent->active_in_hierarchy()
 			: _active_self;
 	}
 
+	if (_active_hierarchy != was_active_hierarchy)
+	{
+		invalidate_tickables();
+	}
+
 	if (_active_hierarchy && !was_active_hierarchy)
 	{
 		post_enable();
@@ -112,19 +175,35 @@ void Entity::set_parent(const peng::weak_ptr<Entity>& parent, EntityRelationship
 	}
 }
 
-void Entity::add_child(const peng::weak_ptr<Entity>& child, EntityRelationship relationship)
+void Entity::add_child(const EntityHandle& child, EntityRelationship relationship)
 {
-	child->set_parent(weak_this(), relationship);
+	child->set_parent(handle(), relationship);
 }
 
 void Entity::destroy()
 {
-	for (const peng::weak_ptr<Entity>& child : _children)
+	EntitySubsystem::get().destroy_entity(weak_this());
+}
+
+ScriptId Entity::start_script(Script&& script)
+{
+	ScriptScheduler& scheduler = EntitySubsystem::get().scripts();
+
+	// Forget scripts that have already finished so that short lived scripts don't accumulate
+	std::erase_if(_scripts, [&](ScriptId id) { return !scheduler.running(id); });
+
+	const ScriptId id = scheduler.start(std::move(script));
+	if (scheduler.running(id))
 	{
-		child->destroy();
+		_scripts.push_back(id);
 	}
 
-	EntitySubsystem::get().destroy_entity(weak_this());
+	return id;
+}
+
+void Entity::stop_script(ScriptId id)
+{
+	EntitySubsystem::get().scripts().stop(id);
 }
 
 peng::weak_ptr<Entity> Entity::load_entity(const Archive& archive)
@@ -142,15 +221,19 @@ peng::weak_ptr<Entity> Entity::load_child(const Archive& archive, EntityRelation
 
 peng::weak_ptr<Component> Entity::get_component(const peng::shared_ref<const ReflectedType>& component_type)
 {
-	for (const peng::shared_ref<Component>& component : _components)
+	const std::optional<ComponentTypeId> type_id = find_component_type_id(*component_type->info);
+	if (!type_id)
 	{
-		if (component->type() == component_type)
-		{
-			return component;
-		}
+		return {};
 	}
 
-	return {};
+	const int32_t index = find_component(*type_id);
+	if (index < 0)
+	{
+		return {};
+	}
+
+	return _components[index];
 }
 
 peng::weak_ptr<Component> Entity::get_component_in_children(
@@ -161,7 +244,7 @@ peng::weak_ptr<Component> Entity::get_component_in_children(
 		return component;
 	}
 
-	for (const peng::weak_ptr<Entity>& child : _children)
+	for (const EntityHandle& child : _children)
 	{
 		if (peng::weak_ptr<Component> component = child->get_component(component_type))
 		{
@@ -183,6 +266,16 @@ peng::weak_ptr<const Component> Entity::get_component_in_children(
 	return const_cast<Entity*>(this)->get_component_in_children(component_type);
 }
 
+bool Entity::has_component(ComponentTypeId type_id) const noexcept
+{
+	if (type_id < max_masked_component_types)
+	{
+		return (_component_mask[type_id / 64] >> (type_id % 64)) & 1;
+	}
+
+	return find_component(type_id) >= 0;
+}
+
 bool Entity::has_parent() const noexcept
 {
 	return _parent.valid();
@@ -198,38 +291,29 @@ bool Entity::has_activity_parent() const noexcept
 	return has_parent() && (_parent_relationship & EntityRelationship::activity) == EntityRelationship::activity;
 }
 
-math::Matrix4x4f Entity::transform_matrix() const noexcept
+const math::Matrix4x4f& Entity::transform_matrix() const noexcept
 {
-	const math::Matrix4x4f local_matrix = _local_transform.to_matrix();
-
-	if (has_spatial_parent())
-	{
-		return _parent->transform_matrix() * local_matrix;
-	}
-
-	return local_matrix;
+	return _world_matrix;
 }
 
-math::Matrix4x4f Entity::transform_matrix_inv() const noexcept
+const math::Matrix4x4f& Entity::transform_matrix_inv() const noexcept
 {
-	const math::Matrix4x4f local_matrix_inv = _local_transform.to_inverse_matrix();
+	return _world_matrix_inv;
+}
 
-	if (has_spatial_parent())
-	{
-		return local_matrix_inv * _parent->transform_matrix_inv();
-	}
+const math::Matrix4x4f& Entity::local_matrix() const noexcept
+{
+	return _local_matrix;
+}
 
-	return local_matrix_inv;
+const math::Matrix4x4f& Entity::local_matrix_inv() const noexcept
+{
+	return _local_matrix_inv;
 }
 
 math::Vector3f Entity::world_position() const noexcept
 {
-	if (has_spatial_parent())
-	{
-		return transform_matrix().get_translation();
-	}
-
-	return _local_transform.position;
+	return _world_matrix.get_translation();
 }
 
 void Entity::propagate_active_change(bool parent_active)
@@ -238,7 +322,7 @@ void Entity::propagate_active_change(bool parent_active)
 	const bool require_enable = new_active && !_active_hierarchy;
 	const bool require_disable = !new_active && _active_hierarchy;
 
-	for (const peng::weak_ptr<Entity>& child : _children)
+	for (const EntityHandle& child : _children)
 	{
 		if (child && child->has_activity_parent())
 		{
@@ -247,6 +331,11 @@ void Entity::propagate_active_change(bool parent_active)
 	}
 
 	_active_hierarchy = new_active;
+	if (require_enable || require_disable)
+	{
+		invalidate_tickables();
+	}
+
 	if (require_enable)
 	{
 		post_enable();
@@ -256,3 +345,114 @@ void Entity::propagate_active_change(bool parent_active)
 		post_disable();
 	}
 }
+
+void Entity::invalidate_tickables() const
+{
+	// Entities that aren't yet tracked by the entity subsystem will be picked up once they are created
+	if (_tickables_registered)
+	{
+		EntitySubsystem::get().invalidate_tickables();
+	}
+}
+
+void Entity::on_component_added(Component& component, ComponentTypeId type_id)
+{
+	component._type_id = type_id;
+
+	// Only the first component of each type is looked up, matching the order components were added in
+	if (type_id < max_masked_component_types && !has_component(type_id))
+	{
+		const int32_t rank = component_rank(type_id);
+		_component_lookup.insert(_component_lookup.begin() + rank, static_cast<uint16_t>(_components.size() - 1));
+		_component_mask[type_id / 64] |= uint64_t(1) << (type_id % 64);
+	}
+
+	invalidate_tickables();
+
+	// Components of entities in the entity subsystem's indices are indexed as soon as they are added
+	if (_type_index_slot >= 0)
+	{
+		EntitySubsystem::get().index_component(component);
+	}
+}
+
+int32_t Entity::find_component(ComponentTypeId type_id) const noexcept
+{
+	if (type_id < max_masked_component_types)
+	{
+		return has_component(type_id)
+			? _component_lookup[component_rank(type_id)]
+			: -1;
+	}
+
+	for (size_t i = 0; i < _components.size(); i++)
+	{
+		if (_components[i]->_type_id == type_id)
+		{
+			return static_cast<int32_t>(i);
+		}
+	}
+
+	return -1;
+}
+
+int32_t Entity::component_rank(ComponentTypeId type_id) const noexcept
+{
+	const ComponentTypeId word = type_id / 64;
+	const uint64_t lower_bits = (uint64_t(1) << (type_id % 64)) - 1;
+
+	int32_t rank = std::popcount(_component_mask[word] & lower_bits);
+	for (ComponentTypeId i = 0; i < word; i++)
+	{
+		rank += std::popcount(_component_mask[i]);
+	}
+
+	return rank;
+}
+
+void Entity::queue_transform_update() noexcept
+{
+	EntitySubsystem::get().queue_transform_update(*this);
+}
+
+void Entity::update_spatial_depth() noexcept
+{
+	const uint32_t depth = has_spatial_parent()
+		? _parent->_spatial_depth + 1
+		: 0;
+
+	if (depth == _spatial_depth)
+	{
+		return;
+	}
+
+	_spatial_depth = depth;
+
+	for (const EntityHandle& child : _children)
+	{
+		if (child)
+		{
+			child->update_spatial_depth();
+		}
+	}
+}
+
+void Entity::update_transform() noexcept
+{
+	if (_local_matrix_dirty.exchange(false, std::memory_order_relaxed))
+	{
+		_local_matrix = _local_transform.to_matrix();
+		_local_matrix_inv = _local_transform.to_inverse_matrix();
+	}
+
+	if (has_spatial_parent())
+	{
+		_world_matrix = _parent->_world_matrix * _local_matrix;
+		_world_matrix_inv = _local_matrix_inv * _parent->_world_matrix_inv;
+	}
+	else
+	{
+		_world_matrix = _local_matrix;
+		_world_matrix_inv = _local_matrix_inv;
+	}
+}
@@ -1,20 +1,27 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <vector>
 #include <memory>
 
 #include <memory/weak_ptr.h>
+#include <memory/pool_allocator.h>
 #include <math/transform.h>
 
 #include "tickable.h"
+#include "tick_rate.h"
+#include "script.h"
 #include "serializable.h"
 #include "entity_relationship.h"
+#include "entity_state.h"
 #include "entity_definition.h"
+#include "component_type_id.h"
+#include "component_batch.h"
+#include "handle.h"
 
 class Component;
 
-// TODO: using weak_ptr for entity handle has bad -> performance due to lock
-//       investigate alternative solutions
 class Entity :
     public ITickable,
     public Serializable,
@@ -23,33 +30,52 @@ class Entity :
 	DECLARE_ENTITY(Entity);
 
 	friend EntitySubsystem;
+	friend Component;
 
 public:
+	using handle_base = Entity;
+
 	explicit Entity(std::string&& name, TickGroup tick_group = TickGroup::standard);
 	explicit Entity(const std::string& name, TickGroup tick_group = TickGroup::standard);
 
 	Entity(const Entity&) = delete;
 	Entity(Entity&&) = delete;
+	~Entity() override;
 
 	void tick(float delta_time) override;
 	[[nodiscard]] TickGroup tick_group() const noexcept override;
 
+	// Throttled entities are ticked less often than every frame, see TickRate
+	void set_tick_rate(const TickRate& tick_rate);
+	[[nodiscard]] const TickRate& tick_rate() const noexcept { return _tick_rate; }
+
 	virtual void post_create();
 	virtual void pre_destroy();
 	virtual void post_enable() { }
 	virtual void post_disable() { }
 
 	void set_active(bool active);
-	void set_parent(const peng::weak_ptr<Entity>& parent, EntityRelationship relationship = EntityRelationship::full);
-	void add_child(const peng::weak_ptr<Entity>& child, EntityRelationship relationship = EntityRelationship::full);
+	void set_parent(const EntityHandle& parent, EntityRelationship relationship = EntityRelationship::full);
+	void add_child(const EntityHandle& child, EntityRelationship relationship = EntityRelationship::full);
 	void destroy();
 
+	// Starts a coroutine script owned by the entity, running it until it first suspends
+	// Scripts must only be started from the main thread, and are stopped when the entity is destroyed
+	ScriptId start_script(Script&& script);
+
+	// Stops a script started by the entity, which is a no op if it has already finished
+	void stop_script(ScriptId id);
+
 	// TODO: add a way to clone entities
 
 	template <std::derived_from<Entity> T, typename...Args>
 	requires std::constructible_from<T, Args...>
 	peng::weak_ptr<T> create_entity(Args&&...args);
 
+	template <std::derived_from<Entity> T, typename F, typename...Args>
+	requires std::constructible_from<T, const Args&...> && std::invocable<F&, T&, size_t>
+	void create_entities(size_t count, F&& init, const Args&...args);
+
 	template <std::derived_from<Entity> T, typename...Args>
     requires std::constructible_from<T, Args...>
 	peng::weak_ptr<T> create_child(Args&&...args);
@@ -86,6 +112,13 @@ public:
 	template <std::derived_from<Component> T>
 	[[nodiscard]] peng::weak_ptr<const T> get_component_in_children() const;
 
+	// Component lookups by type are constant time, and has_component only tests a bit in the entity's component mask
+	// As with get_component, only components of exactly type T are considered
+	template <std::derived_from<Component> T>
+	[[nodiscard]] bool has_component() const;
+
+	[[nodiscard]] bool has_component(ComponentTypeId type_id) const noexcept;
+
 	template <std::derived_from<Entity> T>
 	[[nodiscard]] bool is_type() const;
 
@@ -95,24 +128,37 @@ public:
 	template <std::derived_from<Entity> T>
 	[[nodiscard]] peng::weak_ptr<const T> as_type() const;
 
+	// Renames the entity, keeping the entity subsystem's name index up to date
+	void set_name(const std::string& name);
+
 	[[nodiscard]] const std::string& name() const noexcept { return _name; }
 	[[nodiscard]] bool active_in_hierarchy() const noexcept { return _active_hierarchy; }
 	[[nodiscard]] bool active_self() const noexcept { return _active_self; }
 
-	[[nodiscard]] peng::weak_ptr<Entity> parent() noexcept { return _parent; }
-	[[nodiscard]] peng::weak_ptr<const Entity> parent() const noexcept { return _parent; }
-	[[nodiscard]] const std::vector<peng::weak_ptr<Entity>>& children() const noexcept { return _children; }
+	[[nodiscard]] const HandleId& handle_id() const noexcept { return _handle_id; }
+	[[nodiscard]] EntityHandle parent() noexcept { return _parent; }
+	[[nodiscard]] Handle<const Entity> parent() const noexcept { return _parent; }
+	[[nodiscard]] const std::vector<EntityHandle>& children() const noexcept { return _children; }
 
 	[[nodiscard]] bool has_parent() const noexcept;
 	[[nodiscard]] bool has_spatial_parent() const noexcept;
 	[[nodiscard]] bool has_activity_parent() const noexcept;
 
-	[[nodiscard]] math::Matrix4x4f transform_matrix() const noexcept;
-	[[nodiscard]] math::Matrix4x4f transform_matrix_inv() const noexcept;
-	[[nodiscard]] math::Transform& local_transform() noexcept { return _local_transform; }
+	// World and local matrices are cached, and only computed by the entity subsystem's transform pass at the start of
+	// each tick group, for entities whose transform or spatial parent changed since the last pass
+	// Reading them never writes the cache, so reads from parallel tick groups see the matrices as of the group's start
+	[[nodiscard]] const math::Matrix4x4f& transform_matrix() const noexcept;
+	[[nodiscard]] const math::Matrix4x4f& transform_matrix_inv() const noexcept;
+	[[nodiscard]] const math::Matrix4x4f& local_matrix() const noexcept;
+	[[nodiscard]] const math::Matrix4x4f& local_matrix_inv() const noexcept;
+
+	// Mutable access queues the entity for the next transform pass, so the reference must not be held across tick groups
+	// Safe to call from parallel tick groups
+	[[nodiscard]] math::Transform& local_transform() noexcept { invalidate_local_transform(); return _local_transform; }
 	[[nodiscard]] const math::Transform& local_transform() const noexcept { return _local_transform; }
 	[[nodiscard]] const std::vector<peng::shared_ref<Component>>& components() const noexcept { return _components; }
 
+	// Read from the cached world matrix, so like the matrices only reflects moves as of the last transform pass
 	[[nodiscard]] math::Vector3f world_position() const noexcept;
 	// TODO: implement world_rotation
 	// TODO: implement world_scale
@@ -121,24 +167,85 @@ public:
 	// TODO: implement world_right
 
 protected:
+	// Must only be changed through set_name once the entity is created
 	std::string _name;
 	TickGroup _tick_group;
-	math::Transform _local_transform;
 
 private:
 	void propagate_active_change(bool parent_active);
+	void invalidate_tickables() const;
+	void on_component_added(Component& component, ComponentTypeId type_id);
+
+	// Finds the first component added of the given type, returning an index into _components or -1
+	[[nodiscard]] int32_t find_component(ComponentTypeId type_id) const noexcept;
+	[[nodiscard]] int32_t component_rank(ComponentTypeId type_id) const noexcept;
+
+	void invalidate_local_transform() noexcept
+	{
+		_local_matrix_dirty.store(true, std::memory_order_relaxed);
+		invalidate_transform();
+	}
+
+	// Queues the entity for the next transform pass unless it already is
+	void invalidate_transform() noexcept
+	{
+		if (!_transform_queued.load(std::memory_order_relaxed) && !_transform_queued.exchange(true, std::memory_order_relaxed))
+		{
+			queue_transform_update();
+		}
+	}
+
+	void queue_transform_update() noexcept;
+	void update_spatial_depth() noexcept;
+
+	// Only called by the transform pass, once the spatial parent's transform is up to date
+	void update_transform() noexcept;
 
 	bool _constructed;
 	bool _created;
+	bool _tickables_registered;
+	bool _destroying;
+	bool _parallel_post_create;
 	bool _active_self;
 	bool _active_hierarchy;
 
-	peng::weak_ptr<Entity> _parent;
+	EntityState _state;
+	TickRate _tick_rate;
+	TickRateState _tick_rate_state;
+	int32_t _name_index_slot;
+	int32_t _type_index_slot;
+
+	// Increases with the order entities are created in, so that lookups by name can prefer the oldest entity
+	uint64_t _creation_index;
+	HandleId _handle_id;
+	EntityHandle _parent;
 	EntityRelationship _parent_relationship;
 
-	std::vector<peng::weak_ptr<Entity>> _children;
+	// Only accessed through local_transform() so that changes are tracked
+	math::Transform _local_transform;
+
+	math::Matrix4x4f _local_matrix;
+	math::Matrix4x4f _local_matrix_inv;
+	math::Matrix4x4f _world_matrix;
+	math::Matrix4x4f _world_matrix_inv;
+	std::atomic<bool> _local_matrix_dirty;
+	std::atomic<bool> _transform_queued;
+	// Number of spatial ancestors, which is the hierarchy level the transform pass updates the entity in
+	uint32_t _spatial_depth;
+	// The last transform pass to visit the entity, so that each pass updates it at most once
+	uint32_t _transform_pass;
+
+	std::vector<EntityHandle> _children;
 	std::vector<peng::shared_ref<Component>> _components;
 	std::vector<peng::shared_ref<Component>> _deferred_components;
+	std::vector<ScriptId> _scripts;
+
+	// Each component type with an ID below max_masked_component_types sets a bit in _component_mask
+	// The number of set bits below a type's bit is its position in _component_lookup, which indexes into _components
+	// Types with larger IDs fall back to a scan of _components
+	static constexpr ComponentTypeId max_masked_component_types = 128;
+	std::array<uint64_t, max_masked_component_types / 64> _component_mask;
+	std::vector<uint16_t> _component_lookup;
 };
 
 template <std::derived_from<Entity> T, typename...Args>
@@ -148,6 +255,13 @@ peng::weak_ptr<T> Entity::create_entity(Args&&...args)
 	return EntitySubsystem::get().create_entity<T>(std::forward<Args>(args)...);
 }
 
+template <std::derived_from<Entity> T, typename F, typename...Args>
+requires std::constructible_from<T, const Args&...> && std::invocable<F&, T&, size_t>
+void Entity::create_entities(size_t count, F&& init, const Args&...args)
+{
+	EntitySubsystem::get().create_entities<T>(count, std::forward<F>(init), args...);
+}
+
 template <std::derived_from<Entity> T, typename...Args>
 requires std::constructible_from<T, Args...>
 peng::weak_ptr<T> Entity::create_child(Args&&...args)
@@ -168,8 +282,20 @@ peng::weak_ptr<T> Entity::create_child(Args&&... args)
 template <std::derived_from<Component> T, typename...Args>
 peng::weak_ptr<T> Entity::add_component(Args&&...args)
 {
-	peng::shared_ref<T> component = peng::make_shared<T>(std::forward<Args>(args)...);
+	peng::shared_ref<T> component = [&]
+	{
+		if constexpr (batch_tickable<T>)
+		{
+			return ComponentStorage<T>::get().make(std::forward<Args>(args)...);
+		}
+		else
+		{
+			return memory::make_pooled<T>(std::forward<Args>(args)...);
+		}
+	}();
+
 	_components.push_back(component);
+	on_component_added(*component.get(), component_type_id<T>());
 
 	if (_constructed)
 	{
@@ -203,9 +329,13 @@ peng::weak_ptr<T> Entity::require_component()
 template <std::derived_from<Component> T>
 peng::weak_ptr<T> Entity::get_component()
 {
-	const peng::shared_ref<const ReflectedType> reflected_type = ReflectionDatabase::get().reflect_type_checked<T>();
-	const peng::weak_ptr<Component> component = get_component(reflected_type);
-	return peng::weak_ptr<T>(std::static_pointer_cast<T>(component.lock().get_impl()));
+	const int32_t index = find_component(component_type_id<T>());
+	if (index < 0)
+	{
+		return {};
+	}
+
+	return peng::shared_ptr<T>(std::static_pointer_cast<T>(_components[index].get_impl()));
 }
 
 template <std::derived_from<Component> T>
@@ -217,9 +347,20 @@ peng::weak_ptr<const T> Entity::get_component() const
 template <std::derived_from<Component> T>
 peng::weak_ptr<T> Entity::get_component_in_children()
 {
-	const peng::shared_ref<const ReflectedType> reflected_type = ReflectionDatabase::get().reflect_type_checked<T>();
-	const peng::weak_ptr<Component> component = get_component_in_children(reflected_type);
-	return peng::weak_ptr<T>(std::static_pointer_cast<T>(component.lock().get_impl()));
+	if (peng::weak_ptr<T> component = get_component<T>())
+	{
+		return component;
+	}
+
+	for (const EntityHandle& child : _children)
+	{
+		if (peng::weak_ptr<T> component = child->get_component<T>())
+		{
+			return component;
+		}
+	}
+
+	return {};
 }
 
 template <std::derived_from<Component> T>
@@ -228,6 +369,12 @@ peng::weak_ptr<const T> Entity::get_component_in_children() const
 	return const_cast<Entity*>(this)->get_component_in_children<T>();
 }
 
+template <std::derived_from<Component> T>
+bool Entity::has_component() const
+{
+	return has_component(component_type_id<T>());
+}
+
 template <std::derived_from<Entity> T>
 bool Entity::is_type() const
 {
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+
+#include <utils/delegate.h>
+
+// A deferred change to entities recorded into an EntityCommandBuffer
+// Commands are stored inline, so recording one doesn't allocate unless its arguments exceed the inline storage
+struct EntityCommand
+{
+	static constexpr size_t inline_size = 64;
+
+	uint64_t order;
+	utils::Delegate<void(), inline_size> apply;
+};
+
+// Orders the entity commands recorded on the calling thread
+// The entity subsystem sets the order to the position of each tickable within its tick group before ticking it
+namespace command_order
+{
+	void set(uint64_t order) noexcept;
+	[[nodiscard]] uint64_t get() noexcept;
+}
@@ -0,0 +1,60 @@
+#include "entity_command_buffer.h"
+
+namespace command_order
+{
+	static thread_local uint64_t current_order = 0;
+
+	void set(uint64_t order) noexcept
+	{
+		current_order = order;
+	}
+
+	uint64_t get() noexcept
+	{
+		return current_order;
+	}
+}
+
+void EntityCommandBuffer::destroy(const EntityHandle& entity)
+{
+	record([entity]
+	{
+		if (Entity* target = entity.get())
+		{
+			target->destroy();
+		}
+	});
+}
+
+void EntityCommandBuffer::set_parent(const EntityHandle& entity, const EntityHandle& parent, EntityRelationship relationship)
+{
+	record([entity, parent, relationship]
+	{
+		if (Entity* target = entity.get())
+		{
+			target->set_parent(parent, relationship);
+		}
+	});
+}
+
+void EntityCommandBuffer::set_active(const EntityHandle& entity, bool active)
+{
+	record([entity, active]
+	{
+		if (Entity* target = entity.get())
+		{
+			target->set_active(active);
+		}
+	});
+}
+
+void EntityCommandBuffer::set_local_transform(const EntityHandle& entity, const math::Transform& transform)
+{
+	record([entity, transform]
+	{
+		if (Entity* target = entity.get())
+		{
+			target->local_transform() = transform;
+		}
+	});
+}
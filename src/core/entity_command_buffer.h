@@ -0,0 +1,82 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <concepts>
+#include <functional>
+
+#include "entity.h"
+#include "component.h"
+#include "entity_command.h"
+
+// Records changes to entities that are applied at the entity subsystem's next flush, and is safe to use from parallel
+// tick groups. Each thread records into its own buffer without locking, retrieved through EntitySubsystem::commands()
+//
+// Buffers are merged ordered by the position of the tickable that recorded each command, then by the order the commands
+// were recorded in, so the result doesn't depend on how tickables were spread across threads
+class EntityCommandBuffer
+{
+	friend EntitySubsystem;
+
+public:
+	EntityCommandBuffer() = default;
+	EntityCommandBuffer(const EntityCommandBuffer&) = delete;
+	EntityCommandBuffer(EntityCommandBuffer&&) = delete;
+
+	// Arguments are copied until the entity is created, after which init is invoked on it
+	template <std::derived_from<Entity> T, std::invocable<T&> Init, typename...Args>
+	requires std::constructible_from<T, Args...>
+	void create_entity(Init&& init, Args&&...args);
+
+	template <std::derived_from<Component> T, typename...Args>
+	void add_component(const EntityHandle& entity, Args&&...args);
+
+	void destroy(const EntityHandle& entity);
+	void set_parent(
+		const EntityHandle& entity,
+		const EntityHandle& parent,
+		EntityRelationship relationship = EntityRelationship::full
+	);
+	void set_active(const EntityHandle& entity, bool active);
+	void set_local_transform(const EntityHandle& entity, const math::Transform& transform);
+
+	[[nodiscard]] bool empty() const noexcept { return _commands.empty(); }
+
+private:
+	template <typename F>
+	void record(F&& apply);
+
+	std::vector<EntityCommand> _commands;
+};
+
+template <std::derived_from<Entity> T, std::invocable<T&> Init, typename...Args>
+requires std::constructible_from<T, Args...>
+void EntityCommandBuffer::create_entity(Init&& init, Args&&...args)
+{
+	record([init = std::forward<Init>(init), ...args = std::forward<Args>(args)]() mutable
+	{
+		const peng::weak_ptr<T> entity = EntitySubsystem::get().create_entity<T>(std::move(args)...);
+		init(*entity.lock().get());
+	});
+}
+
+template <std::derived_from<Component> T, typename...Args>
+void EntityCommandBuffer::add_component(const EntityHandle& entity, Args&&...args)
+{
+	record([entity, ...args = std::forward<Args>(args)]() mutable
+	{
+		if (Entity* target = entity.get())
+		{
+			target->add_component<T>(std::move(args)...);
+		}
+	});
+}
+
+template <typename F>
+void EntityCommandBuffer::record(F&& apply)
+{
+	_commands.push_back(EntityCommand{
+		.order = command_order::get(),
+		.apply = std::forward<F>(apply)
+	});
+}
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <type_traits>
+
+#include "handle.h"
 #include "detail/entity_definition_bootstrap.h"
 
 #define DECLARE_ENTITY(EntityType) \
@@ -18,6 +21,22 @@ public: \
 	{ \
 		return peng::weak_ptr<const EntityType>(std::static_pointer_cast<const EntityType>(shared_from_this())); \
 	} \
+	\
+	[[nodiscard]] Handle<EntityType> handle() noexcept \
+	{ \
+		return Handle<EntityType>(handle_id()); \
+	} \
+	\
+	[[nodiscard]] Handle<const EntityType> handle() const noexcept \
+	{ \
+		return Handle<const EntityType>(handle_id()); \
+	} \
+	\
+	/* Entities whose type doesn't override Entity::tick are never ticked */ \
+	[[nodiscard]] virtual bool overrides_tick() const noexcept \
+	{ \
+		return !std::is_same_v<decltype(&EntityType::tick), void (Entity::*)(float)>; \
+	} \
 private: \
 	static core::detail::EntityDefinitionBootstrap<EntityType> _definition_bootstrap
 
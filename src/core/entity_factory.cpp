@@ -1,7 +1,11 @@
 #include "entity_factory.h"
 
+#include <profiling/scoped_event.h>
+
 #include "entity.h"
+#include "component.h"
 #include "archive.h"
+#include "prefab.h"
 #include "component_factory.h"
 
 peng::weak_ptr<Entity> EntityFactory::create_entity(
@@ -145,3 +149,80 @@ void EntityFactory::load_entity_children(const Archive& entity_archive, const pe
 		}
 	}
 }
+
+peng::weak_ptr<Entity> EntityFactory::instantiate(const Prefab& prefab)
+{
+	if (!prefab.valid())
+	{
+		Logger::error("Could not instantiate prefab '%s' as it failed to compile", prefab.name().c_str());
+		return {};
+	}
+
+	// Reused between instantiations as it only tracks the entities of the copy being instantiated
+	_prefab_instances.clear();
+
+	for (const Prefab::EntityNode& node : prefab._nodes)
+	{
+		// Children of entities that failed to be created are skipped, as they are when loading
+		const bool parent_missing = node.parent >= 0 && !_prefab_instances[node.parent];
+		peng::weak_ptr<Entity> entity = parent_missing
+			? peng::weak_ptr<Entity>()
+			: create_entity(node.type, node.name);
+
+		_prefab_instances.push_back(entity);
+		if (!entity)
+		{
+			continue;
+		}
+
+		if (node.compiled)
+		{
+			node.compiled->apply(*entity.lock().get());
+		}
+
+		for (const Prefab::ComponentNode& component_node : node.components)
+		{
+			const peng::weak_ptr<Component> component = ComponentFactory::get().create_component(component_node.type, entity);
+			if (component_node.compiled)
+			{
+				component_node.compiled->apply(*component.lock().get());
+			}
+		}
+
+		if (node.parent >= 0)
+		{
+			// TODO: support serialized parent relationships other than full
+			entity->set_parent(_prefab_instances[node.parent]);
+		}
+	}
+
+	return _prefab_instances.front();
+}
+
+std::vector<peng::weak_ptr<Entity>> EntityFactory::instantiate(const Prefab& prefab, size_t count)
+{
+	SCOPED_EVENT("EntityFactory - instantiate prefab", strtools::catf_temp("%s x%d", prefab.name().c_str(), count));
+
+	std::vector<peng::weak_ptr<Entity>> instances;
+	instances.reserve(count);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		if (peng::weak_ptr<Entity> instance = instantiate(prefab))
+		{
+			instances.push_back(std::move(instance));
+		}
+	}
+
+	return instances;
+}
+
+std::unique_ptr<Serializable> EntityFactory::create_prototype(const peng::shared_ref<const ReflectedType>& entity_type) const
+{
+	if (!_prototype_factory.has_factory(entity_type))
+	{
+		return nullptr;
+	}
+
+	return _prototype_factory.construct_item(entity_type);
+}
@@ -1,14 +1,20 @@
 #pragma once
 
+#include <memory>
+#include <optional>
+
 #include <memory/weak_ptr.h>
 
 #include "logger.h"
+#include "serializable.h"
 #include "item_factory.h"
 #include "reflection_database.h"
 #include "entity_subsystem.h"
 
 struct Archive;
 class Entity;
+class Serializable;
+class Prefab;
 
 class EntityFactory : public utils::Singleton<EntityFactory>
 {
@@ -31,6 +37,17 @@ public:
 	// Returns nullptr if the load failed
 	peng::weak_ptr<Entity> load_entity(const Archive& archive);
 
+	// Instantiates a copy of the prefab's entity along with its components and children
+	// Returns nullptr if the prefab is invalid
+	peng::weak_ptr<Entity> instantiate(const Prefab& prefab);
+
+	// Instantiates count copies of the prefab, returning the root entity of each copy
+	std::vector<peng::weak_ptr<Entity>> instantiate(const Prefab& prefab, size_t count);
+
+	// Constructs an entity of the given type that is never added to the entity subsystem, for compiling archives against
+	// Returns nullptr if the type has no viable constructors
+	[[nodiscard]] std::unique_ptr<Serializable> create_prototype(const peng::shared_ref<const ReflectedType>& entity_type) const;
+
 private:
 	struct EntityConstructorSet
 	{
@@ -46,7 +63,9 @@ private:
 
 	ItemFactory<peng::weak_ptr<Entity>> _default_factory;
 	ItemFactory<peng::weak_ptr<Entity>, const std::string&> _named_factory;
+	ItemFactory<std::unique_ptr<Serializable>> _prototype_factory;
 	std::unordered_map<peng::shared_ref<const ReflectedType>, EntityConstructorSet> _type_to_constructor_set;
+	std::vector<peng::weak_ptr<Entity>> _prefab_instances;
 };
 
 template <std::derived_from<Entity> T>
@@ -63,6 +82,11 @@ void EntityFactory::register_entity()
 		};
 
 		_default_factory.register_factory(entity_type, entity_constructor);
+		_prototype_factory.register_factory(entity_type, []() -> std::unique_ptr<Serializable>
+		{
+			return std::make_unique<T>();
+		});
+
 		constructor_set.has_default = true;
 	}
 
@@ -75,6 +99,14 @@ void EntityFactory::register_entity()
 
 		_named_factory.register_factory(entity_type, entity_constructor);
 		constructor_set.has_named = true;
+
+		if constexpr (!std::is_constructible_v<T>)
+		{
+			_prototype_factory.register_factory(entity_type, [name = entity_type->name]() -> std::unique_ptr<Serializable>
+			{
+				return std::make_unique<T>(name);
+			});
+		}
 	}
 
 	if (constructor_set.has_default || constructor_set.has_named)
@@ -0,0 +1,9 @@
+#pragma once
+
+enum class EntityState
+{
+	invalid,
+	valid,
+	pending_add,
+	pending_kill
+};
\ No newline at end of file
@@ -1,16 +1,25 @@
 ﻿#include "entity_subsystem.h"
 
-#include <execution>
 #include <algorithm>
 #include <utils/vectools.h>
 #include <profiling/scoped_event.h>
+#include <threading/job_system.h>
+#include <threading/parallel.h>
 
 #include "entity.h"
 #include "component.h"
+#include "entity_command_buffer.h"
 #include "logger.h"
 
 EntitySubsystem::EntitySubsystem()
     : Subsystem()
+	, _tickables_dirty(false)
+	, _num_queued_transforms(0)
+	, _transform_pass(0)
+	, _batched_ticking(true)
+	, _scheduled_ticking(true)
+	, _next_creation_index(0)
+	, _command_buffers_generation(0)
 {
 	constexpr int32_t start = static_cast<int32_t>(TickGroup::standard);
 	constexpr int32_t end = static_cast<int32_t>(TickGroup::none);
@@ -20,9 +29,18 @@ EntitySubsystem::EntitySubsystem()
 		const TickGroup group = static_cast<TickGroup>(tick_group);
 		_tick_groups.push_back(group);
 		_tick_group_names.push_back(strtools::cat(group));
+		_tick_schedules.emplace_back(threading::JobSystem::get());
 	}
+
+	_tickables.resize(_tick_groups.size());
+	_tick_batches.resize(_tick_groups.size());
+	_tick_group_access.resize(_tick_groups.size());
+	_tick_throttlers.resize(_tick_groups.size());
+	_tick_group_budgets.resize(_tick_groups.size());
 }
 
+EntitySubsystem::~EntitySubsystem() = default;
+
 void EntitySubsystem::start()
 {
     
@@ -33,13 +51,48 @@ void EntitySubsystem::shutdown()
 	SCOPED_EVENT("EntitySubsystem - shutdown");
 	Logger::log("Destroying all entities");
 
-	for (peng::shared_ref<Entity>& entity : _entities)
+	for (const peng::shared_ref<Entity>& entity : _entities)
+	{
+		entity->_destroying = true;
+		entity->_state = EntityState::invalid;
+	}
+
+	for (const peng::shared_ref<Entity>& entity : _entities)
 	{
 		// TODO: add a destroy reason (explicit / shutdown)
 		entity->pre_destroy();
 	}
 
+	_scripts.stop_all();
+
+	_entity_name_index.clear();
+	_entity_type_index.clear();
+	_component_type_index.clear();
+
+	for (std::vector<ITickable*>& tickables : _tickables)
+	{
+		tickables.clear();
+	}
+
+	for (std::vector<std::unique_ptr<IComponentBatch>>& batches : _tick_batches)
+	{
+		batches.clear();
+	}
+
+	for (TickScheduler& schedule : _tick_schedules)
+	{
+		schedule.reset();
+	}
+
+	{
+		// Threads look their buffers up again on their next use, as the generation no longer matches
+		std::lock_guard lock(_command_buffers_mutex);
+		_command_buffers.clear();
+		_command_buffers_generation++;
+	}
+
 	_pending_adds.clear();
+	_pending_kills.clear();
 	_entities.clear();
 }
 
@@ -48,68 +101,91 @@ void EntitySubsystem::tick(float delta_time)
 	SCOPED_EVENT("EntitySubsystem - tick");
 
 	flush_pending_actions();
+	_scripts.tick(delta_time);
 	tick_entities(delta_time);
 }
 
 void EntitySubsystem::register_entity(const peng::shared_ref<Entity>& entity)
 {
 	entity->_constructed = true;
+	entity->_state = EntityState::pending_add;
+	entity->invalidate_transform();
 	_pending_adds.push_back(entity);
 }
 
 void EntitySubsystem::destroy_entity(const peng::weak_ptr<Entity>& entity)
 {
-	if (!entity.valid())
+	const peng::shared_ptr<Entity> strong_entity = entity.lock();
+	if (!strong_entity)
 	{
 		Logger::error("Cannot destroy invalid entity");
 		return;
 	}
 
-	// TODO: check if entity is already queued for destruction
-	_pending_kills.push_back(entity);
-	for (const peng::weak_ptr<Entity>& child : entity->children())
-	{
-		destroy_entity(child);
-	}
+	queue_kill(*strong_entity.get());
 }
 
-EntityState EntitySubsystem::get_entity_state(const peng::weak_ptr<Entity>& entity) const
+void EntitySubsystem::queue_kill(Entity& entity)
 {
-	if (vectools::contains(_pending_kills, entity))
+	// Entities already queued or being destroyed have had their descendants queued too
+	if (entity._state != EntityState::valid && entity._state != EntityState::pending_add)
 	{
-		return EntityState::pending_kill;
+		return;
 	}
 
-	if (const peng::shared_ptr<Entity> strong_entity = entity.lock())
+	entity._state = EntityState::pending_kill;
+	_pending_kills.push_back(entity.handle());
+
+	for (const EntityHandle& child : entity.children())
 	{
-		const peng::shared_ref<Entity> entity_ref = strong_entity.to_shared_ref();
-		if (vectools::contains(_entities, entity_ref))
-		{
-			return EntityState::valid;
-		}
-		if (vectools::contains(_pending_adds, entity_ref))
+		if (Entity* child_entity = child.get())
 		{
-			return EntityState::pending_add;
+			queue_kill(*child_entity);
 		}
 	}
+}
+
+EntityState EntitySubsystem::get_entity_state(const peng::weak_ptr<Entity>& entity) const
+{
+	if (const peng::shared_ptr<Entity> strong_entity = entity.lock())
+	{
+		return strong_entity->_state;
+	}
 
 	return EntityState::invalid;
 }
 
 peng::weak_ptr<Entity> EntitySubsystem::find_entity(const std::string& entity_name, bool include_inactive) const
 {
-	for (const peng::shared_ref<Entity>& entity : _entities)
+	// The name index is unordered, so the oldest match is found explicitly
+	Entity* oldest = nullptr;
+	for (Entity* entity : find_entities(entity_name))
 	{
-		if (include_inactive || entity->active_in_hierarchy())
+		if ((include_inactive || entity->active_in_hierarchy())
+			&& (!oldest || entity->_creation_index < oldest->_creation_index))
 		{
-			if (entity->name() == entity_name)
-			{
-				return entity;
-			}
+			oldest = entity;
 		}
 	}
 
-	return {};
+	return oldest
+		? oldest->weak_this()
+		: peng::weak_ptr<Entity>();
+}
+
+std::span<Entity* const> EntitySubsystem::find_entities(const std::string& entity_name) const
+{
+	return _entity_name_index.find(entity_name);
+}
+
+std::span<Entity* const> EntitySubsystem::find_entities_of_type(const ReflectedType& entity_type) const
+{
+	return _entity_type_index.find(&entity_type);
+}
+
+std::span<Component* const> EntitySubsystem::components_of_type(const ReflectedType& component_type) const
+{
+	return _component_type_index.find(&component_type);
 }
 
 std::vector<peng::weak_ptr<Entity>> EntitySubsystem::all_entities()
@@ -125,6 +201,70 @@ std::vector<peng::weak_ptr<Entity>> EntitySubsystem::all_entities()
 	return result;
 }
 
+void EntitySubsystem::set_batched_ticking(bool enabled)
+{
+	if (enabled != _batched_ticking)
+	{
+		_batched_ticking = enabled;
+		invalidate_tickables();
+	}
+}
+
+void EntitySubsystem::set_scheduled_ticking(bool enabled)
+{
+	if (enabled != _scheduled_ticking)
+	{
+		_scheduled_ticking = enabled;
+		invalidate_tickables();
+	}
+}
+
+int32_t EntitySubsystem::peak_scheduled_concurrency(TickGroup tick_group) const
+{
+	const size_t group_index = static_cast<size_t>(tick_group);
+	check(group_index < _tick_schedules.size());
+
+	return _tick_schedules[group_index].peak_concurrency();
+}
+
+void EntitySubsystem::set_tick_group_access(TickGroup tick_group, const TickAccess& access)
+{
+	const size_t group_index = static_cast<size_t>(tick_group);
+	check(group_index < _tick_group_access.size());
+
+	// The schedule refers to the old declaration, which is about to be released
+	_tick_schedules[group_index].reset();
+	_tick_group_access[group_index] = std::make_unique<TickAccess>(access);
+	invalidate_tickables();
+}
+
+void EntitySubsystem::clear_tick_group_access(TickGroup tick_group)
+{
+	const size_t group_index = static_cast<size_t>(tick_group);
+	check(group_index < _tick_group_access.size());
+
+	_tick_schedules[group_index].reset();
+	_tick_group_access[group_index].reset();
+	invalidate_tickables();
+}
+
+void EntitySubsystem::set_tick_group_budget(TickGroup tick_group, double budget_ms)
+{
+	const size_t group_index = static_cast<size_t>(tick_group);
+	check(group_index < _tick_group_budgets.size());
+	check(budget_ms > 0);
+
+	_tick_group_budgets[group_index] = timing::duration_ms(budget_ms);
+}
+
+void EntitySubsystem::clear_tick_group_budget(TickGroup tick_group)
+{
+	const size_t group_index = static_cast<size_t>(tick_group);
+	check(group_index < _tick_group_budgets.size());
+
+	_tick_group_budgets[group_index].reset();
+}
+
 void EntitySubsystem::dump_hierarchy() const
 {
 	if constexpr (!Logger::enabled())
@@ -132,12 +272,12 @@ void EntitySubsystem::dump_hierarchy() const
 		return;
 	}
 
-	std::vector<peng::weak_ptr<Entity>> root_entities;
+	std::vector<EntityHandle> root_entities;
 	for (const peng::shared_ref<Entity>& entity : _entities)
 	{
 		if (!entity->parent().valid())
 		{
-			root_entities.emplace_back(entity);
+			root_entities.push_back(entity->handle());
 		}
 	}
 
@@ -154,53 +294,98 @@ void EntitySubsystem::dump_hierarchy() const
 
 void EntitySubsystem::tick_entities(float delta_time)
 {
-	std::vector<peng::shared_ref<ITickable>> tickables;
-
 	for (size_t i = 0; i < _tick_groups.size(); i++)
 	{
 		const TickGroup tick_group = _tick_groups[i];
+		const timing::clock::time_point group_start = timing::clock::now();
 
 		{
 			SCOPED_EVENT("EntitySubsystem - pre tick entity group", _tick_group_names[i].c_str());
 			_pre_tick_entity_group.invoke(tick_group);
 		}
 
-		// Gather tickables for the current group
-		for (const peng::shared_ref<Entity>& entity : _entities)
+		// Pending actions or activity changes from the previous group may have invalidated the cached lists
+		if (_tickables_dirty)
 		{
-			if (entity->active_in_hierarchy())
-			{
-				if (entity->tick_group() == tick_group)
-				{
-					tickables.emplace_back(entity);
-				}
-
-				for (const peng::shared_ref<Component>& component : entity->components())
-				{
-					if (component->tick_group() == tick_group)
-					{
-						tickables.emplace_back(component);
-					}
-				}
-			}
+			rebuild_tickables();
 		}
 
+		// Transforms are only computed by the transform pass, so bring any moved since the last group up to date
+		update_transforms();
+
+		const bool parallel = is_parallel_tick_group(tick_group);
+
 		{
 			SCOPED_EVENT("EntitySubsystem - ticking entity group", _tick_group_names[i].c_str());
 
+			// Commands recorded by each tickable are ordered by its position across the group's lists
+			const std::vector<ITickable*>& tickables = _tickables[i];
 			for_each_tickable(
-				is_parallel_tick_group(tick_group),
+				parallel,
 				tickables,
-				[&](const peng::shared_ref<ITickable>& tickable)
+				[&](ITickable* const& tickable)
 				{
+					command_order::set(&tickable - tickables.data());
 					tickable->tick(delta_time);
 				});
+
+			uint64_t order = tickables.size();
+
+			// Declared tickables run after the undeclared ones, which may have moved entities on the main thread
+			TickScheduler& schedule = _tick_schedules[i];
+			if (schedule.concurrent())
+			{
+				update_transforms();
+			}
+
+			schedule.tick(delta_time, order);
+			order += schedule.order_span();
+
+			for (const std::unique_ptr<IComponentBatch>& batch : _tick_batches[i])
+			{
+				if (schedule.contains(*batch))
+				{
+					continue;
+				}
+
+				SCOPED_EVENT("EntitySubsystem - tick component batch", strtools::catf_temp("%d components", batch->size()));
+				batch->tick_all(delta_time, parallel, order);
+				order += batch->num_slots();
+			}
+
+			// Throttled tickables run last so that budgeted ones can be deferred based on the rest of the group
+			std::optional<timing::clock::time_point> deadline;
+			if (const std::optional<timing::duration_ms>& budget = _tick_group_budgets[i])
+			{
+				deadline = group_start + std::chrono::duration_cast<timing::clock::duration>(*budget);
+			}
+
+			_tick_throttlers[i].tick(delta_time, order, deadline);
+
+			order += _tick_throttlers[i].size();
+
+			// Anything recorded outside of a tick is ordered after the group's tickables
+			command_order::set(order);
 		}
 
 		// Flush pending lifecycle updates (creation/destruction) after each group
-		tickables.clear();
 		flush_pending_actions();
 
+		if (const std::optional<timing::duration_ms>& budget = _tick_group_budgets[i])
+		{
+			const timing::duration_ms group_time = timing::clock::now() - group_start;
+			if (group_time > *budget)
+			{
+				Logger::warning(
+					"Tick group '%s' over budget by %.3fms (%.3fms of %.3fms)",
+					_tick_group_names[i].c_str(),
+					(group_time - *budget).count(),
+					group_time.count(),
+					budget->count()
+				);
+			}
+		}
+
 		{
 			SCOPED_EVENT("EntitySubsystem - post tick entity group", _tick_group_names[i].c_str());
 			_post_tick_entity_group.invoke(tick_group);
@@ -210,74 +395,551 @@ void EntitySubsystem::tick_entities(float delta_time)
 
 void EntitySubsystem::flush_pending_actions()
 {
+	flush_commands();
 	flush_pending_kills();
 	flush_pending_adds();
 }
 
+EntityCommandBuffer& EntitySubsystem::commands()
+{
+	// Buffers are owned by the subsystem so that commands outlive the threads that recorded them
+	// Each thread caches its buffer along with the subsystem and generation it belongs to, so that a buffer released
+	// by shutting the subsystem down is never reused
+	struct CachedBuffer
+	{
+		const EntitySubsystem* owner = nullptr;
+		uint32_t generation = 0;
+		EntityCommandBuffer* buffer = nullptr;
+	};
+
+	thread_local CachedBuffer cached;
+	if (cached.owner != this || cached.generation != _command_buffers_generation.load(std::memory_order_acquire))
+	{
+		std::lock_guard lock(_command_buffers_mutex);
+		cached = CachedBuffer{
+			.owner = this,
+			.generation = _command_buffers_generation.load(std::memory_order_relaxed),
+			.buffer = _command_buffers.emplace_back(std::make_unique<EntityCommandBuffer>()).get()
+		};
+	}
+
+	return *cached.buffer;
+}
+
+void EntitySubsystem::flush_commands()
+{
+	{
+		std::lock_guard lock(_command_buffers_mutex);
+		for (const std::unique_ptr<EntityCommandBuffer>& buffer : _command_buffers)
+		{
+			std::ranges::move(buffer->_commands, std::back_inserter(_merged_commands));
+			buffer->_commands.clear();
+		}
+	}
+
+	if (_merged_commands.empty())
+	{
+		return;
+	}
+
+	SCOPED_EVENT("EntitySubsystem - flush commands", strtools::catf_temp("%d commands", _merged_commands.size()));
+
+	// Each tickable only records on a single thread, so a stable sort keeps its commands in the order they were recorded
+	std::ranges::stable_sort(_merged_commands, std::less(), &EntityCommand::order);
+
+	// Commands recorded while applying are left in the buffers for the next flush
+	for (EntityCommand& command : _merged_commands)
+	{
+		command.apply();
+	}
+
+	_merged_commands.clear();
+}
+
+void EntitySubsystem::queue_transform_update(Entity& entity)
+{
+	const size_t slot = _num_queued_transforms.fetch_add(1, std::memory_order_relaxed);
+	if (slot < _queued_transforms.size())
+	{
+		_queued_transforms[slot] = entity.handle();
+		return;
+	}
+
+	std::lock_guard lock(_overflow_transforms_mutex);
+	_overflow_transforms.emplace_back(entity.handle());
+}
+
+void EntitySubsystem::update_transforms()
+{
+	const size_t num_queued = std::min(_num_queued_transforms.load(std::memory_order_relaxed), _queued_transforms.size());
+	if (num_queued == 0 && _overflow_transforms.empty())
+	{
+		return;
+	}
+
+	SCOPED_EVENT(
+		"EntitySubsystem - update transforms",
+		strtools::catf_temp("%zu queued", num_queued + _overflow_transforms.size())
+	);
+
+	// Small levels aren't worth the overhead of dispatching to other threads
+	constexpr size_t min_parallel_level_size = 256;
+
+	_transform_pass++;
+	for (std::vector<Entity*>& level : _transform_levels)
+	{
+		level.clear();
+	}
+
+	// Entities may be queued again by a spatial parent, or through the overflow, but are only updated once per pass
+	const auto add_to_level = [this](Entity& entity)
+	{
+		if (entity._transform_pass == _transform_pass)
+		{
+			return;
+		}
+
+		entity._transform_pass = _transform_pass;
+		entity._transform_queued.store(false, std::memory_order_relaxed);
+
+		if (entity._spatial_depth >= _transform_levels.size())
+		{
+			_transform_levels.resize(entity._spatial_depth + 1);
+		}
+
+		_transform_levels[entity._spatial_depth].push_back(&entity);
+	};
+
+	const auto add_queued = [&add_to_level](const EntityHandle& handle)
+	{
+		if (Entity* entity = handle.get())
+		{
+			add_to_level(*entity);
+		}
+	};
+
+	std::ranges::for_each(std::span(_queued_transforms).first(num_queued), add_queued);
+	std::ranges::for_each(_overflow_transforms, add_queued);
+
+	_num_queued_transforms.store(0, std::memory_order_relaxed);
+	_overflow_transforms.clear();
+
+	for (size_t depth = 0; depth < _transform_levels.size(); depth++)
+	{
+		const auto update = [](Entity* entity)
+		{
+			entity->update_transform();
+		};
+
+		if (_transform_levels[depth].size() >= min_parallel_level_size)
+		{
+			threading::parallel_for(_transform_levels[depth], update, {
+				.grain_size = min_parallel_level_size,
+				.name = "update transforms"
+			});
+		}
+		else
+		{
+			std::ranges::for_each(_transform_levels[depth], update);
+		}
+
+		// Spatial children depend on the world matrix that just changed, so join the next level
+		// Indexing rather than iterating, as adding a level may reallocate the level being walked
+		for (size_t i = 0; i < _transform_levels[depth].size(); i++)
+		{
+			for (const EntityHandle& child : _transform_levels[depth][i]->children())
+			{
+				if (child && child->has_spatial_parent())
+				{
+					add_to_level(*child.get());
+				}
+			}
+		}
+	}
+
+	// Reserve a slot for every entity so that queueing from parallel tick groups doesn't need the overflow
+	const size_t num_entities = _entities.size() + _pending_adds.size();
+	if (_queued_transforms.size() < num_entities)
+	{
+		_queued_transforms.resize(num_entities);
+	}
+}
+
 template <typename F>
-void EntitySubsystem::for_each_tickable(bool parallel, const std::vector<peng::shared_ref<ITickable>>& tickables, F&& invocable)
+void EntitySubsystem::for_each_tickable(bool parallel, const std::vector<ITickable*>& tickables, F&& invocable)
 {
+	// Tick costs vary a lot between tickables, so they're handed out in small chunks for workers to balance
+	constexpr size_t tickable_grain_size = 64;
+
 	if (parallel)
 	{
-		std::for_each(std::execution::par, tickables.begin(), tickables.end(), std::move(invocable));
+		threading::parallel_for(tickables, invocable, {
+			.grain_size = tickable_grain_size,
+			.name = "tickables"
+		});
 	}
 	else
 	{
-		std::for_each(std::execution::seq, tickables.begin(), tickables.end(), std::move(invocable));
+		std::ranges::for_each(tickables, invocable);
 	}
 }
 
 void EntitySubsystem::flush_pending_adds()
 {
 	const std::vector staged_adds(std::move(_pending_adds));
+	_entities.reserve(_entities.size() + staged_adds.size());
 
 	for (const peng::shared_ref<Entity>& entity : staged_adds)
 	{
+		// Entities killed before being created keep their pending kill until the next flush
+		if (entity->_state == EntityState::pending_add)
+		{
+			entity->_state = EntityState::valid;
+		}
+
 		_entities.push_back(entity);
+		index_entity(*entity.get());
 	}
 
+	// New entities must have their transforms computed before post_create can read them
+	update_transforms();
+
+	// Consecutive entities that allow it, such as those created together by create_entities, are created in parallel
+	// Creating deferred components registers them and allocates handles, so entities with any are created serially
+	const auto create_in_parallel = [](const peng::shared_ref<Entity>& entity)
+	{
+		return entity->_parallel_post_create && entity->_deferred_components.empty();
+	};
+
+	for (size_t begin = 0; begin < staged_adds.size();)
+	{
+		size_t end = begin + 1;
+		if (create_in_parallel(staged_adds[begin]))
+		{
+			while (end < staged_adds.size() && create_in_parallel(staged_adds[end]))
+			{
+				end++;
+			}
+		}
+
+		if (end - begin > 1)
+		{
+			SCOPED_EVENT("EntitySubsystem - parallel post create", strtools::catf_temp("%d entities", end - begin));
+			threading::parallel_for(
+				std::span(staged_adds).subspan(begin, end - begin),
+				[](const peng::shared_ref<Entity>& entity)
+				{
+					entity->post_create();
+				},
+				{
+					.grain_size = 16,
+					.name = "post create"
+				});
+		}
+		else
+		{
+			staged_adds[begin]->post_create();
+		}
+
+		begin = end;
+	}
+
+	// Register tickables only once post_create has run so that any components it adds are included
 	for (const peng::shared_ref<Entity>& entity : staged_adds)
 	{
-		entity->post_create();
+		register_tickables(*entity.get());
 	}
 }
 
 void EntitySubsystem::flush_pending_kills()
 {
-	auto kill_in_buffer = [&](std::vector<peng::shared_ref<Entity>>& entities, bool exists_yet)
+	if (_pending_kills.empty())
 	{
-		for (int32_t entity_index = static_cast<int32_t>(entities.size() - 1); entity_index >= 0; entity_index--)
+		return;
+	}
+
+	SCOPED_EVENT("EntitySubsystem - flush pending kills", strtools::catf_temp("%d entities", _pending_kills.size()));
+
+	// Killed entities must never be ticked through a stale cached pointer
+	invalidate_tickables();
+
+	// Anything destroyed from within pre_destroy is queued for the next flush
+	std::vector<EntityHandle> staged_kills;
+	std::swap(staged_kills, _pending_kills);
+
+	for (const EntityHandle& handle : staged_kills)
+	{
+		if (Entity* entity = handle.get())
 		{
-			peng::shared_ref<Entity>& entity = entities[entity_index];
-			peng::weak_ptr<Entity> weak_entity = entity;
+			entity->_destroying = true;
+			entity->_state = EntityState::invalid;
+		}
+	}
 
-			if (vectools::contains(_pending_kills, weak_entity))
-			{
-				if (exists_yet)
-				{
-					entity->pre_destroy();
-				}
+	// Kills are queued parents first, so walk them backwards to tear down children before their parents
+	// Entities that were never created don't receive pre_destroy
+	for (auto it = staged_kills.rbegin(); it != staged_kills.rend(); ++it)
+	{
+		Entity* entity = it->get();
+		if (entity && entity->_created)
+		{
+			entity->pre_destroy();
+		}
+	}
 
-				entities.erase(entities.begin() + entity_index);
+	for (const EntityHandle& handle : staged_kills)
+	{
+		if (Entity* entity = handle.get())
+		{
+			unindex_entity(*entity);
 
-				if (weak_entity.valid())
-				{
-					Logger::warning(
-						"Entity '%s' still exists after kill, potential leak",
-						weak_entity->name().c_str()
-					);
-				}
+			for (const ScriptId script : entity->_scripts)
+			{
+				_scripts.stop(script);
 			}
 		}
+	}
+
+	const auto is_destroying = [](const peng::shared_ref<Entity>& entity)
+	{
+		return entity->_destroying;
 	};
 
-	kill_in_buffer(_entities, true);
-	kill_in_buffer(_pending_adds, false);
+	std::erase_if(_entities, is_destroying);
+	std::erase_if(_pending_adds, is_destroying);
 
-	_pending_kills.clear();
+	for (const EntityHandle& handle : staged_kills)
+	{
+		if (const Entity* entity = handle.get())
+		{
+			Logger::warning("Entity '%s' still exists after kill, potential leak", entity->name().c_str());
+		}
+	}
+}
+
+void EntitySubsystem::index_entity(Entity& entity)
+{
+	entity._creation_index = _next_creation_index++;
+	_entity_name_index.add(entity.name(), entity);
+	_entity_type_index.add(entity.type().get(), entity);
+
+	for (const peng::shared_ref<Component>& component : entity.components())
+	{
+		index_component(*component.get());
+	}
+}
+
+void EntitySubsystem::unindex_entity(Entity& entity)
+{
+	// Entities killed before they were created never made it into the indices
+	if (entity._name_index_slot < 0)
+	{
+		return;
+	}
+
+	_entity_name_index.remove(entity.name(), entity);
+	_entity_type_index.remove(entity.type().get(), entity);
+
+	for (const peng::shared_ref<Component>& component : entity.components())
+	{
+		_component_type_index.remove(component->type().get(), *component.get());
+	}
+}
+
+void EntitySubsystem::index_component(Component& component)
+{
+	_component_type_index.add(component.type().get(), component);
+}
+
+void EntitySubsystem::rename_entity(Entity& entity, const std::string& name)
+{
+	_entity_name_index.remove(entity.name(), entity);
+	entity._name = name;
+	_entity_name_index.add(entity.name(), entity);
+}
+
+int32_t& EntitySubsystem::EntityNameSlot::get(Entity& entity) noexcept
+{
+	return entity._name_index_slot;
+}
+
+int32_t& EntitySubsystem::EntityTypeSlot::get(Entity& entity) noexcept
+{
+	return entity._type_index_slot;
+}
+
+int32_t& EntitySubsystem::ComponentTypeSlot::get(Component& component) noexcept
+{
+	return component._type_index_slot;
+}
+
+void EntitySubsystem::invalidate_tickables() noexcept
+{
+	_tickables_dirty.store(true, std::memory_order_relaxed);
+}
+
+void EntitySubsystem::register_tickables(Entity& entity)
+{
+	entity._tickables_registered = true;
+
+	// Nothing to append if a full rebuild is already pending as it will pick the entity up
+	if (!_tickables_dirty && entity.active_in_hierarchy())
+	{
+		append_tickables(entity);
+	}
+}
+
+void EntitySubsystem::rebuild_tickables()
+{
+	SCOPED_EVENT("EntitySubsystem - rebuild tickables", strtools::catf_temp("%d entities", _entities.size()));
+	_tickables_dirty.store(false, std::memory_order_relaxed);
+
+	for (std::vector<ITickable*>& tickables : _tickables)
+	{
+		tickables.clear();
+	}
+
+	for (TickScheduler& schedule : _tick_schedules)
+	{
+		schedule.clear();
+	}
+
+	for (TickThrottler& throttler : _tick_throttlers)
+	{
+		throttler.clear();
+	}
+
+	_tick_stats = TickStats();
+
+	for (std::vector<std::unique_ptr<IComponentBatch>>& batches : _tick_batches)
+	{
+		for (const std::unique_ptr<IComponentBatch>& batch : batches)
+		{
+			batch->clear();
+		}
+	}
+
+	// Entities still mid creation are skipped as register_tickables will append them once created
+	for (const peng::shared_ref<Entity>& entity : _entities)
+	{
+		if (entity->_tickables_registered && entity->active_in_hierarchy())
+		{
+			append_tickables(*entity.get());
+		}
+	}
+}
+
+void EntitySubsystem::append_tickables(Entity& entity)
+{
+	if (!entity.overrides_tick())
+	{
+		_tick_stats.skipped_tickables++;
+	}
+	else if (entity._tick_rate.throttled())
+	{
+		append_throttled_tickable(entity, entity, entity._tick_rate, entity._tick_rate_state);
+	}
+	else
+	{
+		append_tickable(entity);
+	}
+
+	for (const peng::shared_ref<Component>& component : entity.components())
+	{
+		if (_batched_ticking && component->batched_tick())
+		{
+			append_batched_tickable(*component.get());
+		}
+		else if (!component->overrides_tick())
+		{
+			_tick_stats.skipped_tickables++;
+		}
+		else if (component->_tick_rate.throttled())
+		{
+			append_throttled_tickable(*component.get(), entity, component->_tick_rate, component->_tick_rate_state);
+		}
+		else
+		{
+			append_tickable(*component.get());
+		}
+	}
+}
+
+void EntitySubsystem::append_tickable(ITickable& tickable)
+{
+	const TickGroup tick_group = tickable.tick_group();
+	const size_t group_index = static_cast<size_t>(tick_group);
+	if (group_index >= _tickables.size())
+	{
+		return;
+	}
+
+	if (_scheduled_ticking && is_scheduled_tick_group(tick_group))
+	{
+		const TickAccess* access = tickable.tick_access();
+		if (!access)
+		{
+			access = _tick_group_access[group_index].get();
+		}
+
+		if (access)
+		{
+			_tick_schedules[group_index].add(tickable, *access);
+			_tick_stats.scheduled_tickables++;
+			return;
+		}
+	}
+
+	_tickables[group_index].push_back(&tickable);
+	_tick_stats.tickables++;
+}
+
+void EntitySubsystem::append_throttled_tickable(ITickable& tickable, Entity& owner, const TickRate& rate, TickRateState& state)
+{
+	const size_t group_index = static_cast<size_t>(tickable.tick_group());
+	if (group_index >= _tick_throttlers.size())
+	{
+		return;
+	}
+
+	_tick_throttlers[group_index].add(tickable, owner, rate, state);
+	_tick_stats.throttled_tickables++;
+}
+
+void EntitySubsystem::append_batched_tickable(Component& component)
+{
+	const size_t group_index = static_cast<size_t>(component.tick_group());
+	if (group_index >= _tick_batches.size())
+	{
+		return;
+	}
+
+	std::vector<std::unique_ptr<IComponentBatch>>& batches = _tick_batches[group_index];
+	const auto it = std::ranges::find_if(batches, [&](const std::unique_ptr<IComponentBatch>& batch)
+	{
+		return batch->accepts(component);
+	});
+
+	_tick_stats.batched_components++;
+
+	IComponentBatch& batch = it != batches.end()
+		? **it
+		: *batches.emplace_back(component.create_tick_batch());
+
+	const bool first_component = batch.size() == 0;
+	batch.add(component);
+
+	// Schedules are cleared with the batches, so a batch joins its schedule again with its first component
+	if (first_component && _scheduled_ticking && is_scheduled_tick_group(component.tick_group()))
+	{
+		if (const TickAccess* access = component.tick_access())
+		{
+			_tick_schedules[group_index].add(batch, *access);
+		}
+	}
 }
 
-std::string EntitySubsystem::build_entity_hierarchy(const std::vector<peng::weak_ptr<Entity>>& root_entities) const
+std::string EntitySubsystem::build_entity_hierarchy(const std::vector<EntityHandle>& root_entities) const
 {
 	std::string result;
 	std::vector<bool> draw_vertical;
@@ -287,7 +949,7 @@ std::string EntitySubsystem::build_entity_hierarchy(const std::vector<peng::weak
 }
 
 void EntitySubsystem::build_entity_hierarchy(
-	const std::vector<peng::weak_ptr<Entity>>& root_entities,
+	const std::vector<EntityHandle>& root_entities,
 	int32_t depth,
 	std::vector<bool>& draw_vertical,
 	std::string& result
@@ -301,7 +963,7 @@ void EntitySubsystem::build_entity_hierarchy(
 
 	for (size_t root_index = 0; root_index < root_entities.size(); root_index++)
 	{
-		const peng::weak_ptr<Entity>& root = root_entities[root_index];
+		const EntityHandle& root = root_entities[root_index];
 
 		for (int32_t d = 0; d < depth; d++)
 		{
@@ -1,34 +1,63 @@
 #pragma once
 
+#include <span>
+#include <deque>
 #include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <ranges>
+#include <optional>
 #include <concepts>
 
 #include <memory/shared_ref.h>
 #include <memory/weak_ptr.h>
+#include <memory/pool_allocator.h>
 #include <utils/event.h>
+#include <utils/bucket_index.h>
 
 #include "subsystem.h"
 #include "tickable.h"
+#include "tick_stats.h"
+#include "entity_command.h"
+#include "tick_access.h"
+#include "tick_scheduler.h"
+#include "tick_throttler.h"
+#include "script_scheduler.h"
+#include "handle.h"
+#include "entity_state.h"
+#include "reflection_database.h"
 
-enum class EntityState
+class Entity;
+class Component;
+class IComponentBatch;
+class EntityCommandBuffer;
+
+// Entity types whose post_create is safe to invoke concurrently with other entities of the same type
+// declare static constexpr bool parallel_post_create = true
+//
+// Their post_create runs on worker threads, so it may only touch the entity itself and data that is safe to read
+// concurrently. It must not construct or add components, create or destroy entities, or allocate or release handles,
+// as the handle registry and component registries are only safe to use from the main thread
+// Entities that were given components before being created still create them on the main thread
+template <typename T>
+concept parallel_creatable = requires
 {
-	invalid,
-	valid,
-	pending_add,
-	pending_kill
+	requires T::parallel_post_create;
 };
 
-class Entity;
-
 class EntitySubsystem final : public Subsystem
 {
 	DECLARE_SUBSYSTEM(EntitySubsystem)
 
+	friend Entity;
+
 	DEFINE_EVENT(pre_tick_entity_group, TickGroup)
 	DEFINE_EVENT(post_tick_entity_group, TickGroup)
 
 public:
 	EntitySubsystem();
+	~EntitySubsystem() override;
 
 	// ----------- Engine API -----------
 	void start() override;
@@ -43,6 +72,14 @@ public:
 	requires std::constructible_from<T, Args...>
 	peng::weak_ptr<T> create_entity(Args&&...args);
 
+	// Constructs count entities of type T from copies of args, allocating them from a pool reserved up front
+	// init(T&, size_t index) is invoked on each entity before it is registered, and is where references should be kept
+	// All of the entities are created together by the next flush, with post_create invoked in parallel for
+	// parallel_creatable types
+	template <std::derived_from<Entity> T, typename F, typename...Args>
+	requires std::constructible_from<T, const Args&...> && std::invocable<F&, T&, size_t>
+	void create_entities(size_t count, F&& init, const Args&...args);
+
 	// Register an entity that was constructed externally with the entity manager
 	// Once registered, the entity manager is responsible for the lifetime of the entity
 	void register_entity(const peng::shared_ref<Entity>& entity);
@@ -51,27 +88,105 @@ public:
 	void destroy_entity(const peng::weak_ptr<Entity>& entity);
 
 	[[nodiscard]] EntityState get_entity_state(const peng::weak_ptr<Entity>& entity) const;
+
+	// Finds the first created entity with the name, as several entities may share a name
 	[[nodiscard]] peng::weak_ptr<Entity> find_entity(const std::string& entity_name, bool include_inactive) const;
-	// TODO: add templated and non templated functions for finding entity/entities via type
+
+	// Lookups are backed by indices of all created entities and their components, and return views into them
+	// The views don't allocate, are in no particular order, and are invalidated when pending actions are flushed
+	[[nodiscard]] std::span<Entity* const> find_entities(const std::string& entity_name) const;
+	[[nodiscard]] std::span<Entity* const> find_entities_of_type(const ReflectedType& entity_type) const;
+	[[nodiscard]] std::span<Component* const> components_of_type(const ReflectedType& component_type) const;
+
+	// Finds all entities that are exactly of type T
+	template <std::derived_from<Entity> T>
+	[[nodiscard]] auto find_entities_of_type() const;
+
+	// Finds all components that are exactly of type T
+	template <std::derived_from<Component> T>
+	[[nodiscard]] auto components_of_type() const;
 
 	[[nodiscard]] std::vector<peng::weak_ptr<Entity>> all_entities();
 
+	// Components declared with DECLARE_BATCHED_TICK are ticked per type through tick_all when enabled,
+	// otherwise every component is ticked individually
+	void set_batched_ticking(bool enabled);
+	[[nodiscard]] bool batched_ticking() const noexcept { return _batched_ticking; }
+
+	// Tickables in scheduled tick groups that don't declare their own access fall back to their group's access
+	// Undeclared tickables are otherwise ticked on the main thread, before the rest of the group is scheduled
+	// Batches of component types that declare their access are scheduled alongside them
+	void set_tick_group_access(TickGroup tick_group, const TickAccess& access);
+	void clear_tick_group_access(TickGroup tick_group);
+
+	// When disabled, declared access is ignored and every tickable in scheduled groups is ticked as if undeclared
+	void set_scheduled_ticking(bool enabled);
+	[[nodiscard]] bool scheduled_ticking() const noexcept { return _scheduled_ticking; }
+
+	// The most scheduled jobs that were ticking at once during the group's last tick
+	[[nodiscard]] int32_t peak_scheduled_concurrency(TickGroup tick_group) const;
+
+	// Once a group has been ticking for longer than its budget, due budgeted tickables are deferred to later frames
+	// Overruns of the budget are logged along with the amount the group went over by
+	void set_tick_group_budget(TickGroup tick_group, double budget_ms);
+	void clear_tick_group_budget(TickGroup tick_group);
+
+	// The calling thread's command buffer, for deferring entity changes from parallel tick groups
+	// Commands are applied at the start of the next flush, before any pending kills and adds
+	[[nodiscard]] EntityCommandBuffer& commands();
+
+	// Scripts are resumed once per frame, after pending actions are flushed and before any tick group runs
+	[[nodiscard]] ScriptScheduler& scripts() noexcept { return _scripts; }
+
+	// Stats about the tickables registered for the next tick
+	[[nodiscard]] const TickStats& tick_stats() const noexcept { return _tick_stats; }
+
 	void dump_hierarchy() const;
 	// ----------------------------------
 
 private:
 	void tick_entities(float delta_time);
 	void flush_pending_actions();
+	void flush_commands();
 	void flush_pending_adds();
 	void flush_pending_kills();
 
-	[[nodiscard]] std::string build_entity_hierarchy(const std::vector<peng::weak_ptr<Entity>>& root_entities) const;
+	// Queues an entity whose transform changed for the next transform pass
+	// Safe to call from parallel tick groups
+	void queue_transform_update(Entity& entity);
+
+	// Brings the cached transforms of queued entities and their spatial descendants up to date, one hierarchy level at a
+	// time, so the pass only walks entities that changed since the last one
+	// Entities within a level only depend on the level above, so each level is updated in parallel
+	void update_transforms();
+
+	// Queues the entity and all of its descendants for destruction, skipping any that are already queued
+	void queue_kill(Entity& entity);
+
+	void index_entity(Entity& entity);
+	void unindex_entity(Entity& entity);
+	void index_component(Component& component);
+	void rename_entity(Entity& entity, const std::string& name);
+
+	// Marks the cached tickable lists as stale so they are rebuilt before the next tick group runs
+	// Safe to call from parallel tick groups
+	void invalidate_tickables() noexcept;
+
+	// Appends the tickables of a newly created entity onto the cached lists without a full rebuild
+	void register_tickables(Entity& entity);
+	void rebuild_tickables();
+	void append_tickables(Entity& entity);
+	void append_tickable(ITickable& tickable);
+	void append_batched_tickable(Component& component);
+	void append_throttled_tickable(ITickable& tickable, Entity& owner, const TickRate& rate, TickRateState& state);
+
+	[[nodiscard]] std::string build_entity_hierarchy(const std::vector<EntityHandle>& root_entities) const;
 
 	template <typename F>
-	void for_each_tickable(bool parallel, const std::vector<peng::shared_ref<ITickable>>& tickables, F&& invocable);
+	void for_each_tickable(bool parallel, const std::vector<ITickable*>& tickables, F&& invocable);
 
 	void build_entity_hierarchy(
-		const std::vector<peng::weak_ptr<Entity>>& root_entities,
+		const std::vector<EntityHandle>& root_entities,
 		int32_t depth,
 		std::vector<bool>& draw_vertical,
 		std::string& result
@@ -81,15 +196,92 @@ private:
 	std::vector<std::string> _tick_group_names;
 	std::vector<peng::shared_ref<Entity>> _entities;
 	std::vector<peng::shared_ref<Entity>> _pending_adds;
-	std::vector<peng::weak_ptr<Entity>> _pending_kills;
+	std::vector<EntityHandle> _pending_kills;
+
+	struct EntityNameSlot { static int32_t& get(Entity& entity) noexcept; };
+	struct EntityTypeSlot { static int32_t& get(Entity& entity) noexcept; };
+	struct ComponentTypeSlot { static int32_t& get(Component& component) noexcept; };
+
+	utils::BucketIndex<std::string, Entity, EntityNameSlot> _entity_name_index;
+	uint64_t _next_creation_index;
+	utils::BucketIndex<const ReflectedType*, Entity, EntityTypeSlot> _entity_type_index;
+	utils::BucketIndex<const ReflectedType*, Component, ComponentTypeSlot> _component_type_index;
+
+	// Cached tickables for each tick group, indexed by the group
+	// Raw pointers are safe as the lists are invalidated before any entity is released
+	// Tickables with declared access in scheduled groups are held by the group's schedule instead,
+	// and throttled tickables by the group's throttler
+	std::vector<std::vector<ITickable*>> _tickables;
+	std::deque<TickScheduler> _tick_schedules;
+	std::vector<std::unique_ptr<TickAccess>> _tick_group_access;
+	std::vector<TickThrottler> _tick_throttlers;
+	std::vector<std::optional<timing::duration_ms>> _tick_group_budgets;
+	std::vector<std::vector<std::unique_ptr<IComponentBatch>>> _tick_batches;
+	std::atomic<bool> _tickables_dirty;
+	bool _batched_ticking;
+	bool _scheduled_ticking;
+	TickStats _tick_stats;
+
+	// Queued entities claim a slot without locking, and there's a slot for every entity as each is queued at most once
+	// per pass, so the mutex only guards entities queued beyond that such as those created since the last pass
+	std::vector<EntityHandle> _queued_transforms;
+	std::atomic<size_t> _num_queued_transforms;
+	std::mutex _overflow_transforms_mutex;
+	std::vector<EntityHandle> _overflow_transforms;
+	std::vector<std::vector<Entity*>> _transform_levels;
+	uint32_t _transform_pass;
+
+	std::mutex _command_buffers_mutex;
+	std::vector<std::unique_ptr<EntityCommandBuffer>> _command_buffers;
+	std::atomic<uint32_t> _command_buffers_generation;
+	std::vector<EntityCommand> _merged_commands;
+
+	ScriptScheduler _scripts;
 };
 
 template <std::derived_from<Entity> T, typename...Args>
 requires std::constructible_from<T, Args...>
 peng::weak_ptr<T> EntitySubsystem::create_entity(Args&&...args)
 {
-	peng::shared_ref<T> entity = peng::make_shared<T>(std::forward<Args>(args)...);
+	peng::shared_ref<T> entity = memory::make_pooled<T>(std::forward<Args>(args)...);
 	register_entity(entity);
 
 	return entity;
 }
+
+template <std::derived_from<Entity> T, typename F, typename...Args>
+requires std::constructible_from<T, const Args&...> && std::invocable<F&, T&, size_t>
+void EntitySubsystem::create_entities(size_t count, F&& init, const Args&...args)
+{
+	memory::block_pool<T>().reserve(count);
+	_pending_adds.reserve(_pending_adds.size() + count);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		peng::shared_ref<T> entity = memory::make_pooled<T>(args...);
+		entity->_parallel_post_create = parallel_creatable<T>;
+
+		init(*entity.get(), i);
+		register_entity(entity);
+	}
+}
+
+template <std::derived_from<Entity> T>
+auto EntitySubsystem::find_entities_of_type() const
+{
+	const peng::shared_ref<const ReflectedType> reflected_type = ReflectionDatabase::get().reflect_type_checked<T>();
+	return find_entities_of_type(*reflected_type.get()) | std::views::transform([](Entity* entity)
+	{
+		return static_cast<T*>(entity);
+	});
+}
+
+template <std::derived_from<Component> T>
+auto EntitySubsystem::components_of_type() const
+{
+	const peng::shared_ref<const ReflectedType> reflected_type = ReflectionDatabase::get().reflect_type_checked<T>();
+	return components_of_type(*reflected_type.get()) | std::views::transform([](Component* component)
+	{
+		return static_cast<T*>(component);
+	});
+}
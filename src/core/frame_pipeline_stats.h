@@ -0,0 +1,16 @@
+#pragma once
+
+// Various stats about the previous frame when frames are pipelined
+struct FramePipelineStats
+{
+	// Time the main thread spent waiting for the render thread to finish preparing the frame it submitted
+	float main_wait_ms = 0;
+
+	// Time the render thread spent idle waiting for the main thread to hand it a frame
+	float render_wait_ms = 0;
+
+	float render_prepare_ms = 0;
+
+	// Whether the main thread submitted the frame while it waited on the next frame's jobs, rather than after ticking
+	bool submitted_while_ticking = false;
+};
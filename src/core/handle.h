@@ -0,0 +1,241 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <memory>
+#include <type_traits>
+
+#include <memory/weak_ptr.h>
+#include <utils/check.h>
+#include <utils/singleton.h>
+
+class Entity;
+class Component;
+
+// Identifies a slot in a HandleRegistry
+// The generation is bumped every time a slot is released so that stale handles can be detected
+struct HandleId
+{
+	static constexpr uint32_t invalid_index = ~0u;
+
+	uint32_t index = invalid_index;
+	uint32_t generation = 0;
+
+	bool operator==(const HandleId&) const = default;
+};
+
+// Slot map of all live objects sharing a handle base (Entity or Component)
+// Slots live in fixed size chunks that are never moved or freed, so resolving a handle
+// is a bounds check and a generation compare with no atomic operations or locking
+// Slots are allocated and released from object constructors and destructors, which only happen on the main thread
+template <typename Base>
+class HandleRegistry : public utils::Singleton<HandleRegistry<Base>>
+{
+	friend utils::Singleton<HandleRegistry<Base>>;
+
+public:
+	[[nodiscard]] HandleId allocate(Base* object)
+	{
+		check(object);
+
+		uint32_t index;
+		if (!_free_slots.empty())
+		{
+			index = _free_slots.back();
+			_free_slots.pop_back();
+		}
+		else
+		{
+			index = _num_slots;
+
+			const uint32_t chunk_index = index / chunk_size;
+			check(chunk_index < max_chunks);
+
+			if (!_chunks[chunk_index])
+			{
+				_chunks[chunk_index] = std::make_unique<Slot[]>(chunk_size);
+			}
+
+			_num_slots++;
+		}
+
+		Slot& slot = get_slot(index);
+		slot.object = object;
+
+		return HandleId{ index, slot.generation };
+	}
+
+	void release(const HandleId& id)
+	{
+		check(id.index < _num_slots);
+
+		Slot& slot = get_slot(id.index);
+		check(slot.generation == id.generation);
+
+		slot.object = nullptr;
+		slot.generation++;
+		_free_slots.push_back(id.index);
+	}
+
+	[[nodiscard]] Base* resolve(const HandleId& id) const noexcept
+	{
+		if (id.index >= _num_slots)
+		{
+			return nullptr;
+		}
+
+		const Slot& slot = get_slot(id.index);
+		return slot.generation == id.generation ? slot.object : nullptr;
+	}
+
+	[[nodiscard]] size_t num_live() const noexcept
+	{
+		return _num_slots - _free_slots.size();
+	}
+
+private:
+	struct Slot
+	{
+		Base* object = nullptr;
+		uint32_t generation = 0;
+	};
+
+	static constexpr uint32_t chunk_size = 4096;
+	static constexpr uint32_t max_chunks = 1024;
+
+	HandleRegistry() = default;
+
+	[[nodiscard]] Slot& get_slot(uint32_t index) noexcept
+	{
+		return _chunks[index / chunk_size][index % chunk_size];
+	}
+
+	[[nodiscard]] const Slot& get_slot(uint32_t index) const noexcept
+	{
+		return _chunks[index / chunk_size][index % chunk_size];
+	}
+
+	std::array<std::unique_ptr<Slot[]>, max_chunks> _chunks;
+	std::vector<uint32_t> _free_slots;
+	uint32_t _num_slots = 0;
+};
+
+// Non-owning reference to an entity or component
+// Unlike peng::weak_ptr, dereferencing a handle doesn't need to lock a control block,
+// and a handle becomes invalid as soon as the object it refers to is destructed
+template <typename T>
+class Handle
+{
+public:
+	Handle() = default;
+
+	Handle(std::nullptr_t)
+	{ }
+
+	explicit Handle(const HandleId& id)
+		: _id(id)
+	{ }
+
+	explicit Handle(T& object)
+		: _id(object.handle_id())
+	{ }
+
+	template <typename U>
+	requires std::convertible_to<U*, T*>
+	Handle(const Handle<U>& other)
+		: _id(other.id())
+	{ }
+
+	template <typename U>
+	requires std::convertible_to<U*, T*>
+	Handle(const peng::shared_ref<U>& ref)
+		: _id(ref->handle_id())
+	{ }
+
+	template <typename U>
+	requires std::convertible_to<U*, T*>
+	Handle(const peng::weak_ptr<U>& ptr)
+	{
+		if (const peng::shared_ptr<U> locked = ptr.lock())
+		{
+			_id = locked->handle_id();
+		}
+	}
+
+	[[nodiscard]] T* get() const noexcept
+	{
+		return static_cast<T*>(registry().resolve(_id));
+	}
+
+	[[nodiscard]] T* operator->() const
+	{
+		T* object = get();
+		check(object);
+
+		return object;
+	}
+
+	[[nodiscard]] T& operator*() const
+	{
+		return *operator->();
+	}
+
+	[[nodiscard]] bool valid() const noexcept
+	{
+		return get() != nullptr;
+	}
+
+	explicit operator bool() const noexcept
+	{
+		return valid();
+	}
+
+	[[nodiscard]] const HandleId& id() const noexcept
+	{
+		return _id;
+	}
+
+	// Gets a weak_ptr to the object, for APIs that need to hold shared ownership
+	[[nodiscard]] peng::weak_ptr<T> to_weak_ptr() const
+	{
+		if (T* object = get())
+		{
+			return peng::weak_ptr<T>(std::static_pointer_cast<T>(object->shared_from_this()));
+		}
+
+		return {};
+	}
+
+	// Gets a shared_ref to the object, which must still be valid
+	[[nodiscard]] peng::shared_ref<T> to_shared_ref() const
+	{
+		return peng::shared_ref<T>(std::static_pointer_cast<T>(operator->()->shared_from_this()));
+	}
+
+	template <typename U>
+	[[nodiscard]] bool operator==(const Handle<U>& other) const noexcept
+	{
+		return _id == other.id();
+	}
+
+private:
+	[[nodiscard]] static const auto& registry() noexcept
+	{
+		return HandleRegistry<typename std::remove_const_t<T>::handle_base>::get();
+	}
+
+	HandleId _id;
+};
+
+using EntityHandle = Handle<Entity>;
+using ComponentHandle = Handle<Component>;
+
+template <typename T>
+struct std::hash<Handle<T>>
+{
+	size_t operator()(const Handle<T>& handle) const noexcept
+	{
+		const HandleId& id = handle.id();
+		return std::hash<uint64_t>{}((static_cast<uint64_t>(id.generation) << 32) | id.index);
+	}
+};
\ No newline at end of file
@@ -24,6 +24,8 @@ public:
 		Args&&...args
 	) const;
 
+	[[nodiscard]] bool has_factory(const peng::shared_ref<const ReflectedType>& item_type) const;
+
 private:
 	std::unordered_map<peng::shared_ref<const ReflectedType>, std::function<ItemBase(Args...)>> _type_to_factory;
 };
@@ -53,3 +55,9 @@ ItemBase ItemFactory<ItemBase, Args...>::construct_item(
 		item_type->name.c_str()
 	));
 }
+
+template <typename ItemBase, typename ... Args>
+bool ItemFactory<ItemBase, Args...>::has_factory(const peng::shared_ref<const ReflectedType>& item_type) const
+{
+	return _type_to_factory.contains(item_type);
+}
@@ -27,21 +27,26 @@ void Logger::log(LogSeverity severity, const std::string& message)
 {
 	Log log = {
 		.severity = severity,
-		.message = message,
-		.timestamp = time_now_info(),
 		.frame_number = PengEngine::exists()
 			? PengEngine::get().frame_number()
-			: 0
+			: 0,
+		.timestamp = time(nullptr),
+		.message = message
 	};
 
-    _worker_thread.schedule_job(threading::Job([this, log = std::move(log)]
+	auto job = [this, log = std::move(log)]
 	{
 		log_internal(log);
-	}));
+	};
+
+	static_assert(threading::Job::stored_inline<decltype(job)>, "Logging should never need to allocate a job");
+	_worker_thread.schedule_job(threading::Job(std::move(job)));
 }
 
 void Logger::log_internal(const Log& log)
 {
+	const tm timestamp = time_info(log.timestamp);
+
 	// Open the log file if we haven't already
 	// TODO: we might want to limit the number of old log files to keep
 	if (!_log_file.is_open())
@@ -49,8 +54,8 @@ void Logger::log_internal(const Log& log)
 		// Logger path = logs/YYYY-MM-DD/HH-MM-SS.log
 		const std::string log_path = strtools::catf(
 			"logs/%04d-%02d-%02d/%02d-%02d-%02d.log",
-			1900 + log.timestamp.tm_year, 1 + log.timestamp.tm_mon, log.timestamp.tm_mday,
-			log.timestamp.tm_hour, log.timestamp.tm_min, log.timestamp.tm_sec
+			1900 + timestamp.tm_year, 1 + timestamp.tm_mon, timestamp.tm_mday,
+			timestamp.tm_hour, timestamp.tm_min, timestamp.tm_sec
 		);
 
 		io::create_directories_for_file(log_path);
@@ -97,7 +102,7 @@ void Logger::log_internal(const Log& log)
 	// [HH:MM:SS][F]
 	const std::string time_code = strtools::catf(
 		"[%02d:%02d:%02d][%d] ",
-		log.timestamp.tm_hour, log.timestamp.tm_min, log.timestamp.tm_sec,
+		timestamp.tm_hour, timestamp.tm_min, timestamp.tm_sec,
 		log.frame_number
 	);
 
@@ -119,13 +124,12 @@ void Logger::log_internal(const Log& log)
 	std::cout << "\n";
 }
 
-tm Logger::time_now_info() const
+tm Logger::time_info(time_t time) const
 {
-	const time_t time_now = time(nullptr);
-	tm time_info = {};
-	localtime_s(&time_info, &time_now);
+	tm info = {};
+	localtime_s(&info, &time);
 
-	return time_info;
+	return info;
 }
 #endif
 
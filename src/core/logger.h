@@ -49,12 +49,14 @@ public:
 	consteval static bool enabled();
 
 private:
+	// Kept small enough for the job that carries it to the worker thread to store it inline
+	// The timestamp is only broken down into a calendar time on the worker thread
 	struct Log
 	{
 		LogSeverity severity;
-		std::string message;
-		tm timestamp;
 		int32_t frame_number;
+		time_t timestamp;
+		std::string message;
 	};
 
 	Logger();
@@ -62,7 +64,7 @@ private:
 
 #ifndef NO_LOGGING
     void log_internal(const Log& log);
-	[[nodiscard]] tm time_now_info() const;
+	[[nodiscard]] tm time_info(time_t time) const;
 
 	std::ofstream _log_file;
 	threading::WorkerThread _worker_thread;
@@ -4,6 +4,8 @@
 
 #include <utils/timing.h>
 #include <memory/gc.h>
+#include <memory/frame_arena.h>
+#include <threading/job_system.h>
 #include <rendering/render_queue.h>
 #include <rendering/window_subsystem.h>
 #include <audio/audio_subsystem.h>
@@ -12,6 +14,7 @@
 
 #include "logger.h"
 #include "entity_subsystem.h"
+#include "timer_subsystem.h"
 
 PengEngine::PengEngine()
 	: Singleton()
@@ -22,10 +25,17 @@ PengEngine::PengEngine()
     , _time_scale(1)
 	, _frame_number(0)
 	, _last_frametime(_target_frametime)
+	, _frame_latency(0)
+	, _render_prepare_pending(false)
+	, _render_prepared(0)
 {
+	// The GC takes the thread that constructs it as the main thread
+	memory::GC::get();
+
 	Subsystem::load<rendering::WindowSubsystem>();
 	Subsystem::load<audio::AudioSubsystem>();
 	Subsystem::load<input::InputSubsystem>();
+	Subsystem::load<TimerSubsystem>();
 	Subsystem::load<EntitySubsystem>();
 }
 
@@ -71,6 +81,12 @@ void PengEngine::set_time_scale(float time_scale) noexcept
 	_time_scale = time_scale;
 }
 
+void PengEngine::set_frame_latency(int32_t frame_latency)
+{
+	check(frame_latency >= 0 && frame_latency <= max_frame_latency);
+	_frame_latency = frame_latency;
+}
+
 bool PengEngine::shutting_down() const
 {
 	if (_shutting_down)
@@ -101,6 +117,16 @@ float PengEngine::last_frametime() const noexcept
 	return _last_frametime;
 }
 
+int32_t PengEngine::frame_latency() const noexcept
+{
+	return _frame_latency;
+}
+
+const FramePipelineStats& PengEngine::last_frame_pipeline_stats() const noexcept
+{
+	return _pipeline_stats;
+}
+
 void PengEngine::start()
 {
 	SCOPED_EVENT("PengEngine - start");
@@ -109,6 +135,7 @@ void PengEngine::start()
 	Logger::log("PengEngine starting...");
 
 	Subsystem::start_all();
+	update_render_thread();
 
 	Logger::success("PengEngine started");
 	_on_engine_initialized();
@@ -118,6 +145,10 @@ void PengEngine::shutdown()
 {
 	SCOPED_EVENT("PengEngine - shutdown");
 
+	stop_render_thread();
+
+	// Before the window shuts down, so that resources released by the GC are freed while there's still a GL context
+	memory::GC::get().shutdown();
 	Subsystem::shutdown_all();
 
 	_shutting_down = false;
@@ -130,11 +161,25 @@ void PengEngine::tick()
 {
 	SCOPED_EVENT("Frame", strtools::catf_temp("%d", _frame_number), {255, 200, 255});
 
+	update_render_thread();
+
+	// The first pipelined frame has nothing prepared to submit, so the last frame stays on screen rather than a blank one
+	const bool present = !_render_thread || _render_prepare_pending;
+
 	tick_main();
 	tick_render();
 
 	memory::GC::get().tick();
-	rendering::WindowSubsystem::get().finalize_frame(_target_frametime);
+	rendering::WindowSubsystem::get().finalize_frame(_target_frametime, present);
+
+	// Nothing transient may be used past this point in the frame
+	memory::FrameArena::get().reset();
+
+	// The render thread executes jobs while it prepares, which may use the frame arena, so only starts once it's reset
+	if (_render_thread)
+	{
+		begin_render_prepare();
+	}
 
 	_frame_number++;
 }
@@ -146,12 +191,22 @@ void PengEngine::tick_main()
 	const float frametime_capped =
 		_max_delta_time > 0
 		? std::min(_last_frametime * _time_scale, _max_delta_time)
-		: _last_frametime;
+		: _last_frametime * _time_scale;
 
 	const float delta_time = frametime_capped / 1000.0f;
 	
 	_on_frame_start();
 
+	// The previous frame is submitted once it's prepared, whenever this one leaves the main thread waiting on jobs
+	// The window is the first subsystem to tick and clears the frame without waiting on any, so it's cleared beforehand
+	if (_render_prepare_pending)
+	{
+		threading::JobSystem::set_idle_work([this]
+		{
+			return try_submit_prepared_frame();
+		});
+	}
+
 	Subsystem::tick_all(delta_time);
 
 	_on_frame_end();
@@ -178,5 +233,111 @@ void PengEngine::tick_render()
 	}
 #endif
 
-	rendering::RenderQueue::get().execute();
+	if (!_render_thread)
+	{
+		rendering::RenderQueue::get().execute();
+		return;
+	}
+
+	threading::JobSystem::clear_idle_work();
+
+	// Submits the previous frame if this one never left the main thread idle after the render thread prepared it
+	if (_render_prepare_pending)
+	{
+		wait_render_prepare();
+		rendering::RenderQueue::get().submit_frame();
+	}
+}
+
+void PengEngine::update_render_thread()
+{
+	if (_frame_latency > 0 && !_render_thread)
+	{
+		Logger::log("Pipelining frames with a latency of %d", _frame_latency);
+
+		_render_thread = std::make_unique<threading::WorkerThread>("Render");
+		_render_prepare_end = timing::clock::now();
+	}
+	else if (_frame_latency == 0 && _render_thread)
+	{
+		Logger::log("No longer pipelining frames");
+		stop_render_thread();
+	}
+}
+
+void PengEngine::stop_render_thread()
+{
+	if (!_render_thread)
+	{
+		return;
+	}
+
+	// The last prepared frame is submitted but never presented, so that what it holds is released while GL is alive
+	// Outside of shutdown the window clears it before anything else is drawn, so the frame is dropped
+	if (_render_prepare_pending)
+	{
+		wait_render_prepare();
+		rendering::RenderQueue::get().submit_frame();
+	}
+
+	_render_thread.reset();
+	_pipeline_stats = FramePipelineStats();
+}
+
+void PengEngine::begin_render_prepare()
+{
+	check(!_render_prepare_pending);
+
+	rendering::RenderQueue::get().swap_command_buffers();
+	_render_prepare_pending = true;
+
+	_render_thread->schedule_job(threading::Job([this]
+	{
+		const timing::clock::time_point prepare_start = timing::clock::now();
+		rendering::RenderQueue::get().prepare_frame();
+		const timing::clock::time_point prepare_end = timing::clock::now();
+
+		const timing::duration_ms wait_time = prepare_start - _render_prepare_end;
+		const timing::duration_ms prepare_time = prepare_end - prepare_start;
+
+		_render_thread_stats.render_wait_ms = static_cast<float>(wait_time.count());
+		_render_thread_stats.render_prepare_ms = static_cast<float>(prepare_time.count());
+		_render_prepare_end = prepare_end;
+
+		_render_prepared.release();
+	}));
+}
+
+void PengEngine::wait_render_prepare()
+{
+	SCOPED_EVENT("PengEngine - wait for render thread");
+
+	const float wait_ms = static_cast<float>(timing::measure_ms([this]
+	{
+		_render_prepared.acquire();
+	}));
+
+	end_render_prepare(wait_ms);
+}
+
+bool PengEngine::try_submit_prepared_frame()
+{
+	if (!_render_prepared.try_acquire())
+	{
+		return false;
+	}
+
+	end_render_prepare(0);
+	_pipeline_stats.submitted_while_ticking = true;
+
+	rendering::RenderQueue::get().submit_frame();
+	return true;
+}
+
+void PengEngine::end_render_prepare(float wait_ms)
+{
+	_render_prepare_pending = false;
+
+	_pipeline_stats = _render_thread_stats;
+	_pipeline_stats.main_wait_ms = wait_ms;
 }
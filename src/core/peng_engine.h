@@ -1,8 +1,15 @@
 #pragma once
 
+#include <memory>
+#include <semaphore>
+
 #include <math/vector2.h>
 #include <utils/event.h>
+#include <utils/timing.h>
 #include <utils/singleton.h>
+#include <threading/worker_thread.h>
+
+#include "frame_pipeline_stats.h"
 
 class PengEngine : public utils::Singleton<PengEngine>
 {
@@ -21,10 +28,24 @@ public:
 	void set_max_delta_time(float frametime_ms) noexcept;
 	void set_time_scale(float time_scale) noexcept;
 
+	// The number of frames that rendering lags behind ticking, which is 0 unless opted in to pipelined frames
+	// With a latency of 1, a render thread prepares the commands of each frame while the main thread ticks the next one,
+	// and the main thread submits the prepared frame whenever it's left waiting on jobs, or otherwise once it's done ticking
+	// Changes take effect at the start of the next frame, and the first frame after opting in presents the last one again
+	//
+	// Draws snapshot their per draw uniforms, but parameters set directly on a material apply to whichever frame is
+	// submitted next, so must only be set from the main thread while pipelining
+	void set_frame_latency(int32_t frame_latency);
+
+	// Render commands are double buffered, so rendering can only lag one frame behind
+	static constexpr int32_t max_frame_latency = 1;
+
 	[[nodiscard]] bool shutting_down() const;
 	[[nodiscard]] float time_scale() const noexcept;
 	[[nodiscard]] int32_t frame_number() const noexcept;
 	[[nodiscard]] float last_frametime() const noexcept;
+	[[nodiscard]] int32_t frame_latency() const noexcept;
+	[[nodiscard]] const FramePipelineStats& last_frame_pipeline_stats() const noexcept;
 
 private:
 	PengEngine();
@@ -36,6 +57,18 @@ private:
 	void tick_main();
 	void tick_render();
 
+	// Starts or stops the render thread to match the requested frame latency
+	void update_render_thread();
+	void stop_render_thread();
+
+	// Hands the commands of the frame that just ticked over to the render thread to prepare
+	void begin_render_prepare();
+	void wait_render_prepare();
+	void end_render_prepare(float wait_ms);
+
+	// Submits the prepared frame if the render thread has finished preparing it
+	bool try_submit_prepared_frame();
+
 	bool _executing;
 	bool _shutting_down;
 	float _target_frametime;
@@ -44,4 +77,14 @@ private:
 
 	int32_t _frame_number;
 	float _last_frametime;
+
+	int32_t _frame_latency;
+	bool _render_prepare_pending;
+	std::unique_ptr<threading::WorkerThread> _render_thread;
+	std::binary_semaphore _render_prepared;
+	FramePipelineStats _pipeline_stats;
+
+	// Only written by the render thread while it's preparing a frame
+	FramePipelineStats _render_thread_stats;
+	timing::clock::time_point _render_prepare_end;
 };
\ No newline at end of file
@@ -0,0 +1,180 @@
+#include "prefab.h"
+
+#include <profiling/scoped_event.h>
+
+#include "logger.h"
+#include "reflection_database.h"
+#include "entity_factory.h"
+#include "component_factory.h"
+
+Prefab::Prefab(const Archive& archive)
+	: _name(archive.name)
+	, _valid(true)
+{
+	SCOPED_EVENT("Prefab - compile", _name.c_str());
+	compile_entity(archive.json_def, archive.name, -1);
+	compile_archives();
+}
+
+peng::shared_ref<Prefab> Prefab::load_asset(const Archive& archive)
+{
+	return peng::make_shared<Prefab>(archive);
+}
+
+void Prefab::compile_entity(const nlohmann::json& entity_def, const std::string& name, int32_t parent)
+{
+	const bool inline_def = entity_def.is_string();
+	if (!(inline_def || entity_def.is_object()))
+	{
+		Logger::error("Could not compile prefab '%s' as it is not a entity typename or definition", _name.c_str());
+		_valid = false;
+		return;
+	}
+
+	const std::string entity_type = inline_def
+		? entity_def.get<std::string>()
+		: entity_def.value("type", std::string());
+
+	const peng::shared_ptr<const ReflectedType> reflected_type = ReflectionDatabase::get().reflect_type(entity_type);
+	if (!reflected_type)
+	{
+		Logger::error(
+			"Could not compile prefab '%s' as the type '%s' does not exist",
+			_name.c_str(), entity_type.c_str()
+		);
+
+		_valid = false;
+		return;
+	}
+
+	const int32_t node_index = static_cast<int32_t>(_nodes.size());
+	_nodes.push_back(EntityNode{
+		.type = reflected_type.to_shared_ref(),
+		.name = name,
+		.parent = parent,
+		.archive = {},
+		.components = {},
+		.compiled = std::nullopt
+	});
+
+	if (inline_def)
+	{
+		return;
+	}
+
+	// Components and children become nodes of their own, so they are left out of the entity's archive
+	EntityNode& node = _nodes.back();
+	node.archive.name = name;
+	node.archive.json_def = entity_def;
+	node.archive.json_def.erase("components");
+	node.archive.json_def.erase("children");
+
+	compile_components(entity_def, node);
+
+	if (const auto it = entity_def.find("children"); it != entity_def.end())
+	{
+		if (!it->is_array())
+		{
+			Logger::error("The 'children' entry in the prefab '%s' was not an array", _name.c_str());
+			_valid = false;
+			return;
+		}
+
+		for (const nlohmann::json& child_def : *it)
+		{
+			const std::string child_name = child_def.is_object()
+				? child_def.value("name", std::string())
+				: std::string();
+
+			compile_entity(child_def, child_name, node_index);
+		}
+	}
+}
+
+void Prefab::compile_components(const nlohmann::json& entity_def, EntityNode& node)
+{
+	const auto it = entity_def.find("components");
+	if (it == entity_def.end())
+	{
+		return;
+	}
+
+	if (!it->is_array())
+	{
+		Logger::error("The 'components' entry in the prefab '%s' was not an array", _name.c_str());
+		_valid = false;
+		return;
+	}
+
+	for (const nlohmann::json& component_def : *it)
+	{
+		const bool inline_def = component_def.is_string();
+		const std::string component_type = inline_def
+			? component_def.get<std::string>()
+			: component_def.value("type", std::string());
+
+		const peng::shared_ptr<const ReflectedType> reflected_type = ReflectionDatabase::get().reflect_type(component_type);
+		if (!reflected_type)
+		{
+			Logger::error(
+				"Could not compile component '%s' in the prefab '%s' as the type does not exist",
+				component_type.c_str(), _name.c_str()
+			);
+
+			_valid = false;
+			continue;
+		}
+
+		ComponentNode& component_node = node.components.emplace_back(ComponentNode{
+			.type = reflected_type.to_shared_ref(),
+			.archive = {},
+			.compiled = std::nullopt
+		});
+
+		if (!inline_def)
+		{
+			component_node.archive.json_def = component_def;
+		}
+	}
+}
+
+void Prefab::compile_archives()
+{
+	for (EntityNode& node : _nodes)
+	{
+		node.compiled = compile_archive(node.archive, EntityFactory::get().create_prototype(node.type), *node.type.get());
+
+		for (ComponentNode& component_node : node.components)
+		{
+			component_node.compiled = compile_archive(
+				component_node.archive,
+				ComponentFactory::get().create_prototype(component_node.type),
+				*component_node.type.get()
+			);
+		}
+	}
+}
+
+std::optional<CompiledArchive> Prefab::compile_archive(
+	const Archive& archive,
+	std::unique_ptr<Serializable>&& prototype,
+	const ReflectedType& type
+)
+{
+	// Inline definitions only name a type, so have nothing to deserialize
+	if (archive.json_def.is_null())
+	{
+		return std::nullopt;
+	}
+
+	// Types without viable constructors can't be instantiated either, which the factories report when instantiating
+	if (!prototype)
+	{
+		Logger::error("Could not compile '%s' in the prefab '%s' as it can't be constructed", type.name.c_str(), _name.c_str());
+		_valid = false;
+		return std::nullopt;
+	}
+
+	// The prototype is fresh, so members partially specified by the archive are completed from their default values
+	return prototype->compile(archive);
+}
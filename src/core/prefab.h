@@ -0,0 +1,68 @@
+#pragma once
+
+#include <vector>
+#include <optional>
+
+#include <memory/shared_ref.h>
+
+#include "archive.h"
+#include "reflected_type.h"
+#include "serializable.h"
+
+// An entity definition compiled once into a flat instantiation plan, used to stamp out copies of the entity
+// Types are resolved and serialized members are read from JSON when the prefab is loaded, by compiling each archive
+// against a prototype of its type, so instantiations don't parse, walk or copy any JSON
+// The prefab isn't modified once loaded, so may be instantiated from any thread that may create entities
+// Instantiated through EntityFactory::instantiate
+class Prefab
+{
+	friend class EntityFactory;
+
+public:
+	explicit Prefab(const Archive& archive);
+	Prefab(const Prefab&) = delete;
+	Prefab(Prefab&&) = delete;
+
+	static peng::shared_ref<Prefab> load_asset(const Archive& archive);
+
+	[[nodiscard]] bool valid() const noexcept { return _valid; }
+	[[nodiscard]] const std::string& name() const noexcept { return _name; }
+
+private:
+	struct ComponentNode
+	{
+		peng::shared_ref<const ReflectedType> type;
+		Archive archive;
+
+		// Empty for inline definitions, which only name a type so have nothing to apply
+		std::optional<CompiledArchive> compiled;
+	};
+
+	// Nodes are stored in depth first order, so that parents always come before their children
+	struct EntityNode
+	{
+		peng::shared_ref<const ReflectedType> type;
+		std::string name;
+		int32_t parent;
+		Archive archive;
+		std::vector<ComponentNode> components;
+
+		std::optional<CompiledArchive> compiled;
+	};
+
+	void compile_entity(const nlohmann::json& entity_def, const std::string& name, int32_t parent);
+	void compile_components(const nlohmann::json& entity_def, EntityNode& node);
+
+	// Compiled archives refer to the node archives, so are only compiled once every node is in place
+	void compile_archives();
+
+	[[nodiscard]] std::optional<CompiledArchive> compile_archive(
+		const Archive& archive,
+		std::unique_ptr<Serializable>&& prototype,
+		const ReflectedType& type
+	);
+
+	std::string _name;
+	bool _valid;
+	std::vector<EntityNode> _nodes;
+};
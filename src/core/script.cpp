@@ -0,0 +1,91 @@
+#include "script.h"
+
+#include <utility>
+#include <exception>
+
+#include "script_scheduler.h"
+#include "logger.h"
+
+Script Script::promise_type::get_return_object() noexcept
+{
+	return Script(handle_type::from_promise(*this));
+}
+
+void Script::promise_type::unhandled_exception() noexcept
+{
+	// The script then finishes, and is stopped by the scheduler once it sees the script is done
+	try
+	{
+		throw;
+	}
+	catch (const std::exception& e)
+	{
+		Logger::error("Script stopped by an unhandled exception: %s", e.what());
+	}
+	catch (...)
+	{
+		Logger::error("Script stopped by an unhandled exception");
+	}
+}
+
+Script::Script(handle_type handle) noexcept
+	: _handle(handle)
+{ }
+
+Script::Script(Script&& other) noexcept
+	: _handle(std::exchange(other._handle, nullptr))
+{ }
+
+Script::~Script()
+{
+	// Scripts that were never started are destroyed without running
+	if (_handle)
+	{
+		_handle.destroy();
+	}
+}
+
+Script& Script::operator=(Script&& other) noexcept
+{
+	if (this != &other)
+	{
+		if (_handle)
+		{
+			_handle.destroy();
+		}
+
+		_handle = std::exchange(other._handle, nullptr);
+	}
+
+	return *this;
+}
+
+Script::handle_type Script::release() noexcept
+{
+	return std::exchange(_handle, nullptr);
+}
+
+ScriptWaker::ScriptWaker(Script::handle_type handle) noexcept
+	: _scheduler(handle.promise().scheduler)
+	, _id(handle.promise().id)
+{ }
+
+bool ScriptWaker::running() const noexcept
+{
+	return _scheduler->running(_id);
+}
+
+void ScriptWaker::wake(utils::Delegate<void()>&& on_wake) const
+{
+	_scheduler->wake(_id, std::move(on_wake));
+}
+
+void NextFrameAwaiter::await_suspend(Script::handle_type handle) const
+{
+	handle.promise().scheduler->resume_next_frame(handle.promise().id);
+}
+
+void SecondsAwaiter::await_suspend(Script::handle_type handle) const
+{
+	handle.promise().scheduler->resume_after(handle.promise().id, seconds);
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <tuple>
+#include <cstdint>
+#include <optional>
+#include <coroutine>
+
+#include <utils/event.h>
+#include <utils/delegate.h>
+
+class ScriptScheduler;
+
+struct ScriptId
+{
+	uint32_t index;
+	uint32_t generation;
+};
+
+// Coroutine return type for entity and component scripts, which are started with Entity::start_script
+// Scripts run on the main thread, and are only resumed once what they are awaiting is ready so cost nothing while waiting
+// A script is stopped, destroying its frame, when the entity that started it is destroyed
+class Script
+{
+public:
+	struct promise_type
+	{
+		Script get_return_object() noexcept;
+		std::suspend_always initial_suspend() noexcept { return {}; }
+		std::suspend_always final_suspend() noexcept { return {}; }
+		void return_void() noexcept { }
+
+		// Exceptions can't propagate through the scheduler resuming the script, so are logged and the script stopped
+		void unhandled_exception() noexcept;
+
+		ScriptScheduler* scheduler = nullptr;
+		ScriptId id = {};
+	};
+
+	using handle_type = std::coroutine_handle<promise_type>;
+
+	Script(Script&& other) noexcept;
+	Script(const Script&) = delete;
+	~Script();
+
+	Script& operator=(Script&& other) noexcept;
+	Script& operator=(const Script&) = delete;
+
+	// Transfers ownership of the coroutine to the caller
+	[[nodiscard]] handle_type release() noexcept;
+
+private:
+	explicit Script(handle_type handle) noexcept;
+
+	handle_type _handle;
+};
+
+// Resumes a suspended script on the next frame, used by awaiters that are woken by something other than the scheduler
+class ScriptWaker
+{
+public:
+	explicit ScriptWaker(Script::handle_type handle) noexcept;
+
+	// Whether the script is still running, once stopped any awaiter it was suspended on is gone
+	// Must be called from the thread ticking the scheduler
+	[[nodiscard]] bool running() const noexcept;
+
+	// May be called from any thread, see ScriptScheduler::wake
+	void wake(utils::Delegate<void()>&& on_wake = {}) const;
+
+private:
+	ScriptScheduler* _scheduler;
+	ScriptId _id;
+};
+
+// Resumes the script at the start of the next frame
+struct NextFrameAwaiter
+{
+	[[nodiscard]] bool await_ready() const noexcept { return false; }
+	void await_suspend(Script::handle_type handle) const;
+	void await_resume() const noexcept { }
+};
+
+// Resumes the script once a number of seconds of game time have passed
+struct SecondsAwaiter
+{
+	float seconds;
+
+	[[nodiscard]] bool await_ready() const noexcept { return seconds <= 0; }
+	void await_suspend(Script::handle_type handle) const;
+	void await_resume() const noexcept { }
+};
+
+// Resumes the script at the start of the frame after the event is next invoked, producing the event's arguments
+// The listener is unsubscribed once the awaiter is destroyed, including when the script is stopped while waiting, so the
+// event must outlive the wait, as the events of the script's own entity and its components do
+template <typename...Args>
+struct EventAwaiter
+{
+	utils::EventInterface<Args...>& event;
+	std::optional<std::tuple<Args...>> result;
+	utils::EventInterface<Args...>::listener_handle listener = utils::EventInterface<Args...>::null_handle;
+
+	~EventAwaiter();
+
+	[[nodiscard]] bool await_ready() const noexcept { return false; }
+	void await_suspend(Script::handle_type handle);
+	auto await_resume();
+};
+
+[[nodiscard]] inline NextFrameAwaiter next_frame() noexcept { return {}; }
+[[nodiscard]] inline SecondsAwaiter seconds(float seconds) noexcept { return { seconds }; }
+
+template <typename...Args>
+[[nodiscard]] EventAwaiter<Args...> operator co_await(utils::EventInterface<Args...>& event) noexcept
+{
+	return { event, std::nullopt };
+}
+
+template <typename...Args>
+EventAwaiter<Args...>::~EventAwaiter()
+{
+	// Does nothing once the listener has fired
+	event.unsubscribe(listener);
+}
+
+template <typename...Args>
+void EventAwaiter<Args...>::await_suspend(Script::handle_type handle)
+{
+	// The event may be invoked from any thread, so the result is only written once the scheduler wakes the script,
+	// which skips it if the script and this awaiter are gone by then
+	listener = event.subscribe_once([this, waker = ScriptWaker(handle)](Args...args)
+	{
+		waker.wake([this, ...args = std::move(args)]() mutable
+		{
+			result.emplace(std::move(args)...);
+		});
+	});
+}
+
+template <typename...Args>
+auto EventAwaiter<Args...>::await_resume()
+{
+	if constexpr (sizeof...(Args) == 0)
+	{
+		return;
+	}
+	else if constexpr (sizeof...(Args) == 1)
+	{
+		return std::get<0>(std::move(*result));
+	}
+	else
+	{
+		return std::move(*result);
+	}
+}
@@ -0,0 +1,158 @@
+#include "script_scheduler.h"
+
+#include <profiling/scoped_event.h>
+#include <utils/check.h>
+#include <utils/strtools.h>
+
+ScriptScheduler::ScriptScheduler()
+	: _num_running(0)
+{ }
+
+ScriptScheduler::~ScriptScheduler()
+{
+	stop_all();
+}
+
+ScriptId ScriptScheduler::start(Script&& script)
+{
+	uint32_t index;
+	if (!_free_slots.empty())
+	{
+		index = _free_slots.back();
+		_free_slots.pop_back();
+	}
+	else
+	{
+		index = static_cast<uint32_t>(_slots.size());
+		_slots.push_back({ nullptr, 0 });
+	}
+
+	Slot& slot = _slots[index];
+	slot.handle = script.release();
+	check(slot.handle);
+
+	const ScriptId id = { index, slot.generation };
+	slot.handle.promise().scheduler = this;
+	slot.handle.promise().id = id;
+	_num_running++;
+
+	const ScriptId ids[] = { id };
+	resume(ids);
+
+	return id;
+}
+
+void ScriptScheduler::stop(ScriptId id)
+{
+	if (!running(id))
+	{
+		return;
+	}
+
+	// Bumping the generation invalidates any pending wake ups and timers for the script
+	Slot& slot = _slots[id.index];
+	slot.handle.destroy();
+	slot.handle = nullptr;
+	slot.generation++;
+
+	_free_slots.push_back(id.index);
+	_num_running--;
+}
+
+void ScriptScheduler::stop_all()
+{
+	for (uint32_t i = 0; i < _slots.size(); i++)
+	{
+		stop({ i, _slots[i].generation });
+	}
+
+	_ready.clear();
+	_timers.clear();
+
+	std::lock_guard lock(_woken_mutex);
+	_woken.clear();
+}
+
+void ScriptScheduler::tick(float delta_time)
+{
+	if (_num_running == 0)
+	{
+		_timers.advance(_timers.time() + delta_time, [](ScriptId) { });
+		return;
+	}
+
+	SCOPED_EVENT("ScriptScheduler - tick", strtools::catf_temp("%d scripts", _num_running));
+
+	// Scripts woken while resuming are left for the next tick
+	std::swap(_resuming, _ready);
+	_timers.advance(_timers.time() + delta_time, [&](ScriptId id)
+	{
+		_resuming.push_back(id);
+	});
+
+	{
+		std::lock_guard lock(_woken_mutex);
+		std::swap(_waking, _woken);
+	}
+
+	for (Wake& wake : _waking)
+	{
+		if (running(wake.id))
+		{
+			if (wake.on_wake)
+			{
+				wake.on_wake();
+			}
+
+			_resuming.push_back(wake.id);
+		}
+	}
+
+	_waking.clear();
+
+	resume(_resuming);
+	_resuming.clear();
+}
+
+bool ScriptScheduler::running(ScriptId id) const noexcept
+{
+	return id.index < _slots.size()
+		&& _slots[id.index].generation == id.generation
+		&& _slots[id.index].handle;
+}
+
+void ScriptScheduler::resume_next_frame(ScriptId id)
+{
+	_ready.push_back(id);
+}
+
+void ScriptScheduler::resume_after(ScriptId id, float seconds)
+{
+	_timers.schedule(_timers.time() + seconds, id);
+}
+
+void ScriptScheduler::wake(ScriptId id, utils::Delegate<void()>&& on_wake)
+{
+	std::lock_guard lock(_woken_mutex);
+	_woken.push_back({ id, std::move(on_wake) });
+}
+
+void ScriptScheduler::resume(std::span<const ScriptId> ids)
+{
+	for (const ScriptId id : ids)
+	{
+		// Scripts stopped since they were woken are skipped
+		if (!running(id))
+		{
+			continue;
+		}
+
+		const Script::handle_type handle = _slots[id.index].handle;
+		handle.resume();
+
+		if (handle.done())
+		{
+			stop(id);
+		}
+	}
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <span>
+#include <mutex>
+#include <vector>
+
+#include <utils/delegate.h>
+#include <utils/timer_wheel.h>
+
+#include "script.h"
+
+// Owns and resumes running scripts, see Script
+// Waiting scripts are only touched when they are due, with timed waits held in a timer wheel
+class ScriptScheduler
+{
+public:
+	ScriptScheduler();
+	ScriptScheduler(const ScriptScheduler&) = delete;
+	ScriptScheduler(ScriptScheduler&&) = delete;
+	~ScriptScheduler();
+
+	// Takes ownership of the script and runs it until it first suspends
+	ScriptId start(Script&& script);
+
+	// Destroys the script if it's still running, which is a no op otherwise
+	void stop(ScriptId id);
+	void stop_all();
+
+	// Advances script time, resuming every script that was woken or whose wait has elapsed
+	void tick(float delta_time);
+
+	[[nodiscard]] bool running(ScriptId id) const noexcept;
+	[[nodiscard]] size_t num_running() const noexcept { return _num_running; }
+	[[nodiscard]] double time() const noexcept { return _timers.time(); }
+
+	void resume_next_frame(ScriptId id);
+	void resume_after(ScriptId id, float seconds);
+
+	// Resumes the script on the next tick, and may be called from any thread unlike everything else here
+	// on_wake is invoked on the ticking thread just before the script resumes, and not at all if it was stopped first
+	void wake(ScriptId id, utils::Delegate<void()>&& on_wake);
+
+private:
+	struct Slot
+	{
+		Script::handle_type handle;
+		uint32_t generation;
+	};
+
+	struct Wake
+	{
+		ScriptId id;
+		utils::Delegate<void()> on_wake;
+	};
+
+	void resume(std::span<const ScriptId> ids);
+
+	std::vector<Slot> _slots;
+	std::vector<uint32_t> _free_slots;
+	size_t _num_running;
+
+	utils::TimerWheel<ScriptId> _timers;
+	std::vector<ScriptId> _ready;
+	std::vector<ScriptId> _resuming;
+
+	std::mutex _woken_mutex;
+	std::vector<Wake> _woken;
+	std::vector<Wake> _waking;
+};
@@ -1,7 +1,19 @@
 #include "serializable.h"
 
+#include <utils/check.h>
+
 #include "archive.h"
 
+void CompiledArchive::apply(Serializable& target) const
+{
+	check(_type && typeid(target) == *_type);
+
+	for (const Step& step : _steps)
+	{
+		step(target, *_archive);
+	}
+}
+
 void Serializable::serialize(Archive& archive) const
 {
 	for (const auto& serializer : _serializers)
@@ -18,12 +30,44 @@ void Serializable::deserialize(const Archive& archive)
 	}
 }
 
+CompiledArchive Serializable::compile(const Archive& archive) const
+{
+	CompiledArchive compiled;
+	compiled._type = &typeid(*this);
+	compiled._archive = &archive;
+
+	for (size_t i = 0; i < _deserializers.size(); i++)
+	{
+		if (_compilers[i])
+		{
+			if (CompiledArchive::Step step = _compilers[i](archive))
+			{
+				compiled._steps.push_back(std::move(step));
+			}
+		}
+		else
+		{
+			// Instances of the same type register their deserializers in the same order
+			compiled._steps.push_back([i](Serializable& target, const Archive& target_archive)
+			{
+				target._deserializers[i](target_archive);
+			});
+		}
+	}
+
+	return compiled;
+}
+
 void Serializable::add_serializer(std::function<void(Archive& archive)>&& serializer)
 {
 	_serializers.push_back(serializer);
 }
 
-void Serializable::add_deserializer(std::function<void(const Archive& archive)>&& deserializer)
+void Serializable::add_deserializer(
+	std::function<void(const Archive& archive)>&& deserializer,
+	MemberCompiler&& compiler
+)
 {
 	_deserializers.push_back(deserializer);
-}
\ No newline at end of file
+	_compilers.push_back(std::move(compiler));
+}
@@ -1,13 +1,36 @@
 #pragma once
 
 #include <vector>
+#include <typeinfo>
 #include <functional>
 
 struct Archive;
+class Serializable;
+
+// Deserialization of an archive compiled against a type, which can then be applied to any instance of that type
+// Serialized members have their values read from the archive once when compiling, so applying them doesn't touch JSON
+// Any other deserializers are invoked with the archive when applied, so the archive must outlive the compiled archive
+class CompiledArchive
+{
+public:
+    using Step = std::function<void(Serializable& target, const Archive& archive)>;
+
+    void apply(Serializable& target) const;
+
+private:
+    friend Serializable;
+
+    const std::type_info* _type = nullptr;
+    const Archive* _archive = nullptr;
+    std::vector<Step> _steps;
+};
 
 class Serializable
 {
 public:
+    // Produces a step applying the member's value from the archive, or nullptr if the archive has no value for it
+    using MemberCompiler = std::function<CompiledArchive::Step(const Archive& archive)>;
+
     Serializable() = default;
     virtual ~Serializable() = default;
 
@@ -15,11 +38,22 @@ public:
     virtual void serialize(Archive& archive) const;
     virtual void deserialize(const Archive& archive);
 
+    // Compiles the archive against the dynamic type of this object, see CompiledArchive
+    // Values of members only partially specified by the archive are completed from this object, so it should be
+    // compiled from an object that has not been deserialized yet
+    [[nodiscard]] CompiledArchive compile(const Archive& archive) const;
+
 protected:
     void add_serializer(std::function<void(Archive& archive)>&& serializer);
-    void add_deserializer(std::function<void(const Archive& archive)>&& deserializer);
+
+    // Deserializers without a compiler are invoked with the archive whenever a compiled archive is applied
+    void add_deserializer(
+        std::function<void(const Archive& archive)>&& deserializer,
+        MemberCompiler&& compiler = nullptr
+    );
 
 private:
     std::vector<std::function<void(Archive& archive)>> _serializers;
     std::vector<std::function<void(const Archive& archive)>> _deserializers;
+    std::vector<MemberCompiler> _compilers;
 };
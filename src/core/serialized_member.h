@@ -1,8 +1,10 @@
 #pragma once
 
 #include <string_view>
+#include <type_traits>
 
 #include "archive.h"
+#include "serializable.h"
 
 namespace detail
 {
@@ -22,6 +24,35 @@ namespace detail
 
         return raw_name;
     }
+
+    // Compiles the member to a setter through its member pointer, so the step can be applied to any object of type Self
+    template <typename Self, typename Owner, typename T>
+    Serializable::MemberCompiler compile_member(const Self* self, T Owner::* member, const std::string& name)
+    {
+        if constexpr (std::is_copy_constructible_v<T> && std::is_copy_assignable_v<T>)
+        {
+            return [self, member, name](const Archive& archive) -> CompiledArchive::Step
+            {
+                const auto it = archive.json_def.find(name);
+                if (it == archive.json_def.end())
+                {
+                    return nullptr;
+                }
+
+                T value = self->*member;
+                it->get_to(value);
+
+                return [member, value = std::move(value)](Serializable& target, const Archive&)
+                {
+                    static_cast<Self&>(target).*member = value;
+                };
+            };
+        }
+        else
+        {
+            return nullptr;
+        }
+    }
 }
 
 // Adds serialization for the provided member
@@ -30,6 +61,7 @@ namespace detail
 #define SERIALIZED_MEMBER(member, ...)                                                              \
     do                                                                                              \
     {                                                                                               \
+        using __PE_Self = std::remove_cvref_t<decltype(*this)>;                                     \
         const std::string __PE_name = detail::get_member_name(#member, detail::Str(__VA_ARGS__));   \
         add_serializer([this, name = __PE_name](Archive& archive)                                   \
         {                                                                                           \
@@ -39,5 +71,5 @@ namespace detail
         add_deserializer([this, name = __PE_name](const Archive& archive)                           \
         {                                                                                           \
             archive.try_read(name.c_str(), member);                                                 \
-        });                                                                                         \
+        }, detail::compile_member(this, &__PE_Self::member, __PE_name));                            \
     } while(0)
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include "tick_access.h"
+
+#include <algorithm>
+#include <functional>
+
+TickAccess::TickAccess(std::string name)
+	: _name(std::move(name))
+	, _independent(false)
+{ }
+
+TickAccess& TickAccess::reads(const std::string& resource)
+{
+	return add_read(std::hash<std::string>()(resource));
+}
+
+TickAccess& TickAccess::writes(const std::string& resource)
+{
+	return add_write(std::hash<std::string>()(resource));
+}
+
+TickAccess& TickAccess::independent() noexcept
+{
+	_independent = true;
+	return *this;
+}
+
+bool TickAccess::conflicts_with(const TickAccess& other) const noexcept
+{
+	return intersects(_writes, other._writes)
+		|| intersects(_writes, other._reads)
+		|| intersects(_reads, other._writes);
+}
+
+bool TickAccess::instances_independent() const noexcept
+{
+	return _independent && _writes.empty();
+}
+
+TickAccess& TickAccess::add_read(size_t resource)
+{
+	const auto it = std::ranges::lower_bound(_reads, resource);
+	if (it == _reads.end() || *it != resource)
+	{
+		_reads.insert(it, resource);
+	}
+
+	return *this;
+}
+
+TickAccess& TickAccess::add_write(size_t resource)
+{
+	const auto it = std::ranges::lower_bound(_writes, resource);
+	if (it == _writes.end() || *it != resource)
+	{
+		_writes.insert(it, resource);
+	}
+
+	return *this;
+}
+
+bool TickAccess::intersects(const std::vector<size_t>& lhs, const std::vector<size_t>& rhs) noexcept
+{
+	auto lhs_it = lhs.begin();
+	auto rhs_it = rhs.begin();
+
+	while (lhs_it != lhs.end() && rhs_it != rhs.end())
+	{
+		if (*lhs_it == *rhs_it)
+		{
+			return true;
+		}
+
+		if (*lhs_it < *rhs_it)
+		{
+			++lhs_it;
+		}
+		else
+		{
+			++rhs_it;
+		}
+	}
+
+	return false;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <typeinfo>
+
+// Declares which component types and resources a tickable reads and writes while ticking
+// Tickables in scheduled tick groups that declare their access are ticked on worker threads, concurrently with any
+// other declared tickables they don't conflict with. Undeclared tickables tick on the main thread before them
+//
+// Declared tickables must only touch their own state and the declared resources, so must not create or destroy
+// entities and components. Reading cached entity transforms is declared as reads<Entity>(), while moving the owning
+// entity through local_transform() counts as the tickable's own state, since cached transforms only change between groups
+//
+// Usage:
+//  const TickAccess* tick_access() const noexcept override
+//  {
+//      static const TickAccess access = TickAccess("Camera").reads<Entity>().independent();
+//      return &access;
+//  }
+class TickAccess
+{
+public:
+	explicit TickAccess(std::string name);
+
+	template <typename T>
+	TickAccess& reads();
+
+	template <typename T>
+	TickAccess& writes();
+
+	TickAccess& reads(const std::string& resource);
+	TickAccess& writes(const std::string& resource);
+
+	// Instances don't touch any state shared with each other, so may be ticked concurrently
+	// Has no effect if any resources are written, as every instance would write them
+	TickAccess& independent() noexcept;
+
+	[[nodiscard]] bool conflicts_with(const TickAccess& other) const noexcept;
+	[[nodiscard]] bool instances_independent() const noexcept;
+	[[nodiscard]] const std::string& name() const noexcept { return _name; }
+
+private:
+	TickAccess& add_read(size_t resource);
+	TickAccess& add_write(size_t resource);
+
+	[[nodiscard]] static bool intersects(const std::vector<size_t>& lhs, const std::vector<size_t>& rhs) noexcept;
+
+	std::string _name;
+
+	// Sorted resource keys, which may collide but only ever make the schedule more conservative
+	std::vector<size_t> _reads;
+	std::vector<size_t> _writes;
+	bool _independent;
+};
+
+template <typename T>
+TickAccess& TickAccess::reads()
+{
+	return add_read(typeid(T).hash_code());
+}
+
+template <typename T>
+TickAccess& TickAccess::writes()
+{
+	return add_write(typeid(T).hash_code());
+}
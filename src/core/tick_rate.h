@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+
+// Controls how often a tickable is ticked so that low priority updates can be spread over several frames
+// Throttled tickables are always passed the full time elapsed since they last ticked
+struct TickRate
+{
+	// Ticked once every interval frames
+	int32_t interval = 1;
+
+	// When positive, the interval grows by a frame for every lod_distance units between the owning entity
+	// and the current camera, up to max_interval
+	float lod_distance = 0;
+	int32_t max_interval = 8;
+
+	// Budgeted tickables that are due may be deferred to a later frame while their group is over its time budget
+	bool budgeted = false;
+
+	[[nodiscard]] bool throttled() const noexcept { return interval > 1 || lod_distance > 0 || budgeted; }
+};
+
+// Bookkeeping for throttled ticking, kept by the tickable so that it survives rebuilds of the tickable lists
+struct TickRateState
+{
+	float accumulated_delta = 0;
+	int32_t frames_waited = 0;
+	bool staggered = false;
+};
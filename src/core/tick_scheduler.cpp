@@ -0,0 +1,293 @@
+#include "tick_scheduler.h"
+
+#include <algorithm>
+#include <profiling/scoped_event.h>
+#include <utils/strtools.h>
+
+#include "tick_access.h"
+#include "entity_command.h"
+#include "component_batch.h"
+
+TickScheduler::TickScheduler(threading::JobSystem& job_system)
+	: _job_system(job_system)
+	, _num_tickables(0)
+	, _num_batches(0)
+	, _running_jobs(0)
+	, _peak_running_jobs(0)
+{ }
+
+TickScheduler::Node::Node(const TickAccess& access)
+	: access(&access)
+	, num_dependencies(0)
+	, first_order(0)
+	, pending_dependencies(0)
+	, pending_chunks(0)
+{ }
+
+void TickScheduler::add(ITickable& tickable, const TickAccess& access)
+{
+	_nodes[find_or_add_node(access)].tickables.push_back(&tickable);
+	_num_tickables++;
+}
+
+void TickScheduler::add(IComponentBatch& batch, const TickAccess& access)
+{
+	_nodes[find_or_add_node(access)].batches.push_back(&batch);
+	_num_batches++;
+}
+
+void TickScheduler::clear()
+{
+	for (Node& node : _nodes)
+	{
+		node.tickables.clear();
+		node.batches.clear();
+	}
+
+	_num_tickables = 0;
+	_num_batches = 0;
+}
+
+void TickScheduler::reset()
+{
+	_nodes.clear();
+	_node_lookup.clear();
+	_num_tickables = 0;
+	_num_batches = 0;
+}
+
+bool TickScheduler::contains(const IComponentBatch& batch) const noexcept
+{
+	return std::ranges::any_of(_nodes, [&](const Node& node)
+	{
+		return std::ranges::find(node.batches, &batch) != node.batches.end();
+	});
+}
+
+uint64_t TickScheduler::order_span() const noexcept
+{
+	uint64_t span = _num_tickables;
+	for (const Node& node : _nodes)
+	{
+		for (const IComponentBatch* batch : node.batches)
+		{
+			span += batch->num_slots();
+		}
+	}
+
+	return span;
+}
+
+void TickScheduler::tick(float delta_time, uint64_t order_base)
+{
+	_peak_running_jobs.store(0, std::memory_order_relaxed);
+
+	if (empty())
+	{
+		return;
+	}
+
+	for (Node& node : _nodes)
+	{
+		node.first_order = order_base;
+		order_base += node.tickables.size();
+
+		for (const IComponentBatch* batch : node.batches)
+		{
+			order_base += batch->num_slots();
+		}
+	}
+
+	if (!concurrent())
+	{
+		_peak_running_jobs.store(1, std::memory_order_relaxed);
+
+		for (const Node& node : _nodes)
+		{
+			tick_range(node, 0, node.tickables.size(), delta_time);
+
+			for (size_t i = 0; i < node.batches.size(); i++)
+			{
+				tick_batch(node, i, false, delta_time);
+			}
+		}
+
+		return;
+	}
+
+	SCOPED_EVENT("TickScheduler - tick", strtools::catf_temp("%d nodes", _nodes.size()));
+
+	for (Node& node : _nodes)
+	{
+		node.pending_dependencies = node.num_dependencies;
+	}
+
+	for (size_t i = 0; i < _nodes.size(); i++)
+	{
+		if (_nodes[i].num_dependencies == 0)
+		{
+			dispatch(i, delta_time);
+		}
+	}
+
+	// Dependents are scheduled against the same counter before the jobs they depend on complete,
+	// so it only reaches zero once every node has ticked
+	_job_system.wait(_jobs);
+}
+
+bool TickScheduler::concurrent() const noexcept
+{
+	size_t active_jobs = 0;
+	for (const Node& node : _nodes)
+	{
+		if (!node.tickables.empty())
+		{
+			active_jobs += num_chunks(node);
+		}
+
+		// Batches of independent instances split themselves between workers even when ticked by a single job
+		active_jobs += node.batches.size();
+		if (active_jobs > 1 || (!node.batches.empty() && node.access->instances_independent()))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int32_t TickScheduler::num_chunks(const Node& node) const noexcept
+{
+	// Small chunks aren't worth the overhead of a job
+	constexpr size_t min_chunk_size = 64;
+
+	if (!node.access->instances_independent())
+	{
+		return 1;
+	}
+
+	const size_t chunks = (node.tickables.size() + min_chunk_size - 1) / min_chunk_size;
+	return static_cast<int32_t>(std::clamp<size_t>(chunks, 1, _job_system.concurrency()));
+}
+
+void TickScheduler::dispatch(size_t node_index, float delta_time)
+{
+	Node& node = _nodes[node_index];
+	if (node.tickables.empty() && node.batches.empty())
+	{
+		complete(node_index, delta_time);
+		return;
+	}
+
+	const int32_t chunks = node.tickables.empty() ? 0 : num_chunks(node);
+	const size_t chunk_size = chunks > 0 ? (node.tickables.size() + chunks - 1) / chunks : 0;
+	node.pending_chunks = chunks + static_cast<int32_t>(node.batches.size());
+
+	for (int32_t chunk = 0; chunk < chunks; chunk++)
+	{
+		const size_t begin = chunk * chunk_size;
+		const size_t end = std::min(begin + chunk_size, node.tickables.size());
+
+		_job_system.schedule(threading::Job([this, node_index, begin, end, delta_time]
+		{
+			begin_job();
+			Node& job_node = _nodes[node_index];
+			tick_range(job_node, begin, end, delta_time);
+			end_job();
+
+			if (job_node.pending_chunks.fetch_sub(1) == 1)
+			{
+				complete(node_index, delta_time);
+			}
+		}), _jobs);
+	}
+
+	for (size_t batch = 0; batch < node.batches.size(); batch++)
+	{
+		_job_system.schedule(threading::Job([this, node_index, batch, delta_time]
+		{
+			begin_job();
+			Node& job_node = _nodes[node_index];
+			tick_batch(job_node, batch, job_node.access->instances_independent(), delta_time);
+			end_job();
+
+			if (job_node.pending_chunks.fetch_sub(1) == 1)
+			{
+				complete(node_index, delta_time);
+			}
+		}), _jobs);
+	}
+}
+
+void TickScheduler::complete(size_t node_index, float delta_time)
+{
+	for (const size_t dependent : _nodes[node_index].dependents)
+	{
+		if (_nodes[dependent].pending_dependencies.fetch_sub(1) == 1)
+		{
+			dispatch(dependent, delta_time);
+		}
+	}
+}
+
+size_t TickScheduler::find_or_add_node(const TickAccess& access)
+{
+	const auto [it, inserted] = _node_lookup.try_emplace(&access, _nodes.size());
+	if (inserted)
+	{
+		// Earlier nodes always run first when in conflict, keeping the order deterministic
+		const size_t node_index = _nodes.size();
+		Node& node = _nodes.emplace_back(access);
+
+		for (size_t i = 0; i < node_index; i++)
+		{
+			if (_nodes[i].access->conflicts_with(access))
+			{
+				_nodes[i].dependents.push_back(node_index);
+				node.num_dependencies++;
+			}
+		}
+	}
+
+	return it->second;
+}
+
+void TickScheduler::begin_job() noexcept
+{
+	const int32_t running = _running_jobs.fetch_add(1, std::memory_order_relaxed) + 1;
+
+	int32_t peak = _peak_running_jobs.load(std::memory_order_relaxed);
+	while (running > peak && !_peak_running_jobs.compare_exchange_weak(peak, running, std::memory_order_relaxed))
+	{ }
+}
+
+void TickScheduler::end_job() noexcept
+{
+	_running_jobs.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void TickScheduler::tick_range(const Node& node, size_t begin, size_t end, float delta_time)
+{
+	SCOPED_EVENT("TickScheduler - tick job", strtools::catf_temp("%s: %d tickables", node.access->name().c_str(), end - begin));
+
+	for (size_t i = begin; i < end; i++)
+	{
+		command_order::set(node.first_order + i);
+		node.tickables[i]->tick(delta_time);
+	}
+}
+
+void TickScheduler::tick_batch(const Node& node, size_t batch_index, bool parallel, float delta_time)
+{
+	IComponentBatch& batch = *node.batches[batch_index];
+	SCOPED_EVENT("TickScheduler - tick batch", strtools::catf_temp("%s: %d components", node.access->name().c_str(), batch.size()));
+
+	// Batches take their orders after the node's tickables and any earlier batches
+	uint64_t order_base = node.first_order + node.tickables.size();
+	for (size_t i = 0; i < batch_index; i++)
+	{
+		order_base += node.batches[i]->num_slots();
+	}
+
+	batch.tick_all(delta_time, parallel, order_base);
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <deque>
+#include <atomic>
+#include <vector>
+#include <unordered_map>
+
+#include <threading/job_system.h>
+
+#include "tickable.h"
+
+class TickAccess;
+class IComponentBatch;
+
+// Ticks the tickables of a tick group that declared their access as a graph of jobs on the job system
+// Tickables sharing an access declaration form a single node, which depends on every earlier node it conflicts with
+// Nodes with independent instances are split into chunks that are ticked concurrently
+// Component batches of types that declare their access are ticked by a job each within their type's node
+class TickScheduler
+{
+public:
+	explicit TickScheduler(threading::JobSystem& job_system);
+	TickScheduler(const TickScheduler&) = delete;
+	TickScheduler(TickScheduler&&) = delete;
+
+	void add(ITickable& tickable, const TickAccess& access);
+	void add(IComponentBatch& batch, const TickAccess& access);
+
+	// Removes all tickables but keeps the graph, as access declarations are expected to outlive the scheduler
+	void clear();
+
+	// Removes all tickables and the graph, required when an access declaration is about to be released
+	void reset();
+
+	// Ticks every tickable, helping to execute jobs until all of them are complete
+	// Commands recorded by each tickable are ordered from order_base by its position across the nodes
+	void tick(float delta_time, uint64_t order_base);
+
+	[[nodiscard]] bool empty() const noexcept { return _num_tickables == 0 && _num_batches == 0; }
+	[[nodiscard]] size_t num_tickables() const noexcept { return _num_tickables; }
+	[[nodiscard]] bool contains(const IComponentBatch& batch) const noexcept;
+
+	// The span of command orders used by the next tick, covering every tickable and batch slot
+	[[nodiscard]] uint64_t order_span() const noexcept;
+
+	// Whether ticking will run more than one job at a time, rather than running inline on the calling thread
+	[[nodiscard]] bool concurrent() const noexcept;
+
+	// The most jobs that were ticking at once during the last tick
+	[[nodiscard]] int32_t peak_concurrency() const noexcept { return _peak_running_jobs.load(std::memory_order_relaxed); }
+
+private:
+	struct Node
+	{
+		explicit Node(const TickAccess& access);
+
+		const TickAccess* access;
+		std::vector<ITickable*> tickables;
+		std::vector<IComponentBatch*> batches;
+		std::vector<size_t> dependents;
+		int32_t num_dependencies;
+		uint64_t first_order;
+
+		std::atomic<int32_t> pending_dependencies;
+		std::atomic<int32_t> pending_chunks;
+	};
+
+	[[nodiscard]] int32_t num_chunks(const Node& node) const noexcept;
+	[[nodiscard]] size_t find_or_add_node(const TickAccess& access);
+
+	void dispatch(size_t node_index, float delta_time);
+	void complete(size_t node_index, float delta_time);
+	void begin_job() noexcept;
+	void end_job() noexcept;
+
+	static void tick_range(const Node& node, size_t begin, size_t end, float delta_time);
+	static void tick_batch(const Node& node, size_t batch_index, bool parallel, float delta_time);
+
+	threading::JobSystem& _job_system;
+	threading::JobCounter _jobs;
+
+	std::deque<Node> _nodes;
+	std::unordered_map<const TickAccess*, size_t> _node_lookup;
+	size_t _num_tickables;
+	size_t _num_batches;
+
+	std::atomic<int32_t> _running_jobs;
+	std::atomic<int32_t> _peak_running_jobs;
+};
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+
+// Various stats about the tickables currently registered with the entity subsystem
+struct TickStats
+{
+	int32_t tickables = 0;
+	int32_t scheduled_tickables = 0;
+	int32_t batched_components = 0;
+	int32_t throttled_tickables = 0;
+
+	// Active entities and components skipped entirely as their type doesn't override tick
+	int32_t skipped_tickables = 0;
+};
@@ -0,0 +1,105 @@
+#include "tick_throttler.h"
+
+#include <algorithm>
+
+#include <entities/camera.h>
+
+#include "entity.h"
+#include "entity_command.h"
+
+void TickThrottler::add(ITickable& tickable, const Entity& owner, const TickRate& rate, TickRateState& state)
+{
+	// Tickables sharing an interval start at different phases so that they don't all become due on the same frame
+	if (!state.staggered)
+	{
+		state.frames_waited = static_cast<int32_t>(_entries.size() % std::max(rate.interval, 1));
+		state.staggered = true;
+	}
+
+	_entries.push_back({
+		.tickable = &tickable,
+		.owner = &owner,
+		.rate = &rate,
+		.state = &state
+	});
+}
+
+void TickThrottler::clear()
+{
+	_entries.clear();
+	_cursor = 0;
+}
+
+size_t TickThrottler::tick(float delta_time, uint64_t order_base, std::optional<timing::clock::time_point> deadline)
+{
+	if (_entries.empty())
+	{
+		return 0;
+	}
+
+	std::optional<math::Vector3f> lod_origin;
+	if (const Handle<entities::Camera>& camera = entities::Camera::current())
+	{
+		lod_origin = camera->world_position();
+	}
+
+	const size_t num_entries = _entries.size();
+	const size_t start = _cursor % num_entries;
+	std::optional<size_t> first_deferred;
+	bool ticked_budgeted = false;
+	size_t num_ticked = 0;
+
+	for (size_t i = 0; i < num_entries; i++)
+	{
+		const size_t entry_index = (start + i) % num_entries;
+		const Entry& entry = _entries[entry_index];
+		TickRateState& state = *entry.state;
+
+		state.accumulated_delta += delta_time;
+		if (++state.frames_waited < interval(entry, lod_origin))
+		{
+			continue;
+		}
+
+		if (entry.rate->budgeted)
+		{
+			// The walk starts from the oldest deferred tickable, which is always let through
+			if (ticked_budgeted && deadline && timing::clock::now() >= *deadline)
+			{
+				if (!first_deferred)
+				{
+					first_deferred = entry_index;
+				}
+
+				continue;
+			}
+
+			ticked_budgeted = true;
+		}
+
+		command_order::set(order_base + entry_index);
+		entry.tickable->tick(state.accumulated_delta);
+
+		state.accumulated_delta = 0;
+		state.frames_waited = 0;
+		num_ticked++;
+	}
+
+	// Deferred tickables go first next frame, otherwise the starting point rotates so that no tickable is always first
+	_cursor = first_deferred.value_or(start + 1);
+	return num_ticked;
+}
+
+int32_t TickThrottler::interval(const Entry& entry, const std::optional<math::Vector3f>& lod_origin)
+{
+	const TickRate& rate = *entry.rate;
+	if (rate.lod_distance <= 0 || !lod_origin)
+	{
+		return rate.interval;
+	}
+
+	const float distance = (entry.owner->world_position() - *lod_origin).magnitude();
+	const int32_t lod_interval = rate.interval + static_cast<int32_t>(distance / rate.lod_distance);
+
+	return std::min(lod_interval, std::max(rate.max_interval, rate.interval));
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <vector>
+#include <optional>
+
+#include <math/vector3.h>
+#include <utils/timing.h>
+
+#include "tickable.h"
+#include "tick_rate.h"
+
+class Entity;
+
+// Ticks the throttled tickables of a tick group, see TickRate
+// Each frame only the tickables that are due are ticked, on the calling thread, in a round robin order
+// Due budgeted tickables are deferred once the deadline has passed, and are the first to tick next frame
+// The first due budgeted tickable always ticks, even past the deadline, so that deferred tickables can't starve when
+// the rest of the group alone overruns the budget
+class TickThrottler
+{
+public:
+	void add(ITickable& tickable, const Entity& owner, const TickRate& rate, TickRateState& state);
+	void clear();
+
+	// Ticks every due tickable, returning the number ticked
+	// Commands recorded by each tickable are ordered from order_base by its position in the throttler
+	size_t tick(float delta_time, uint64_t order_base, std::optional<timing::clock::time_point> deadline);
+
+	[[nodiscard]] bool empty() const noexcept { return _entries.empty(); }
+	[[nodiscard]] size_t size() const noexcept { return _entries.size(); }
+
+private:
+	struct Entry
+	{
+		ITickable* tickable;
+		const Entity* owner;
+		const TickRate* rate;
+		TickRateState* state;
+	};
+
+	[[nodiscard]] static int32_t interval(const Entry& entry, const std::optional<math::Vector3f>& lod_origin);
+
+	std::vector<Entry> _entries;
+	size_t _cursor = 0;
+};
@@ -25,3 +25,15 @@ bool is_parallel_tick_group(TickGroup tick_group)
         default: return false;
     }
 }
+
+bool is_scheduled_tick_group(TickGroup tick_group)
+{
+    switch (tick_group)
+    {
+        case TickGroup::standard:        return true;
+        case TickGroup::physics:         return true;
+        case TickGroup::pre_render:      return true;
+        case TickGroup::render_parallel: return true;
+        default: return false;
+    }
+}
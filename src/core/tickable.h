@@ -2,6 +2,8 @@
 
 #include <ostream>
 
+class TickAccess;
+
 enum class TickGroup
 {
 	standard,
@@ -19,7 +21,12 @@ class ITickable
 public:
 	virtual void tick(float delta_time) = 0;
 	[[nodiscard]] virtual TickGroup tick_group() const noexcept = 0;
+
+	// Declaring access allows the tickable to be ticked concurrently in scheduled tick groups, see TickAccess
+	// The declaration must outlive the tickable, so is typically a function local static
+	[[nodiscard]] virtual const TickAccess* tick_access() const noexcept { return nullptr; }
 };
 
 std::ostream& operator<<(std::ostream& os, TickGroup tick_group);
-bool is_parallel_tick_group(TickGroup tick_group);
\ No newline at end of file
+bool is_parallel_tick_group(TickGroup tick_group);
+bool is_scheduled_tick_group(TickGroup tick_group);
\ No newline at end of file
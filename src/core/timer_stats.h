@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstdint>
+
+// Various stats about the timers fired by the timer subsystem in the last frame
+struct TimerStats
+{
+	int32_t fired_timers = 0;
+	int32_t pending_timers = 0;
+	double fire_time_ms = 0;
+};
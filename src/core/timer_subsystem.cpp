@@ -0,0 +1,96 @@
+#include "timer_subsystem.h"
+
+#include <cmath>
+
+#include <utils/timing.h>
+#include <utils/strtools.h>
+#include <profiling/scoped_event.h>
+
+#include "peng_engine.h"
+
+TimerSubsystem::TimerSubsystem()
+	: Subsystem()
+	, _time(0)
+{ }
+
+void TimerSubsystem::start()
+{
+
+}
+
+void TimerSubsystem::shutdown()
+{
+	_time_wheel.clear();
+	_frame_wheel.clear();
+}
+
+void TimerSubsystem::tick(float delta_time)
+{
+	_time += delta_time;
+
+	const size_t num_pending = this->num_pending();
+	_stats = TimerStats();
+	_stats.pending_timers = static_cast<int32_t>(num_pending);
+
+	if (num_pending == 0)
+	{
+		_time_wheel.advance(static_cast<uint64_t>(std::floor(_time * ticks_per_second)), [](callback&) { });
+		_frame_wheel.advance(PengEngine::get().frame_number(), [](callback&) { });
+		return;
+	}
+
+	SCOPED_EVENT("TimerSubsystem - tick", strtools::catf_temp("%d timers", num_pending));
+
+	const auto fire = [this](callback& callback)
+	{
+		callback();
+		_stats.fired_timers++;
+	};
+
+	_stats.fire_time_ms = timing::measure_ms([&]
+	{
+		_frame_wheel.advance(PengEngine::get().frame_number(), fire);
+		_time_wheel.advance(static_cast<uint64_t>(std::floor(_time * ticks_per_second)), fire);
+	});
+}
+
+TimerHandle TimerSubsystem::schedule_at(double time, callback&& callback)
+{
+	// Rounding up means timers never fire before their time
+	const uint64_t tick = static_cast<uint64_t>(std::ceil(std::max(time, 0.0) * ticks_per_second));
+	return { _time_wheel.schedule(tick, std::move(callback)), false };
+}
+
+TimerHandle TimerSubsystem::schedule_after(double delay, callback&& callback)
+{
+	return schedule_at(_time + delay, std::move(callback));
+}
+
+TimerHandle TimerSubsystem::schedule_at_frame(int32_t frame, callback&& callback)
+{
+	return { _frame_wheel.schedule(std::max(frame, 0), std::move(callback)), true };
+}
+
+TimerHandle TimerSubsystem::schedule_after_frames(int32_t frames, callback&& callback)
+{
+	return schedule_at_frame(PengEngine::get().frame_number() + frames, std::move(callback));
+}
+
+bool TimerSubsystem::cancel(TimerHandle handle)
+{
+	return handle.frame_timer
+		? _frame_wheel.cancel(handle.wheel_handle)
+		: _time_wheel.cancel(handle.wheel_handle);
+}
+
+bool TimerSubsystem::pending(TimerHandle handle) const noexcept
+{
+	return handle.frame_timer
+		? _frame_wheel.pending(handle.wheel_handle)
+		: _time_wheel.pending(handle.wheel_handle);
+}
+
+size_t TimerSubsystem::num_pending() const noexcept
+{
+	return _time_wheel.size() + _frame_wheel.size();
+}
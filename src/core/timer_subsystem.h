@@ -0,0 +1,68 @@
+#pragma once
+
+#include <functional>
+
+#include <utils/hierarchical_timer_wheel.h>
+
+#include "subsystem.h"
+#include "timer_stats.h"
+
+// A scheduled callback, which may be cancelled until it fires
+struct TimerHandle
+{
+	utils::HierarchicalTimerWheel<std::function<void()>>::Handle wheel_handle;
+	bool frame_timer;
+};
+
+// Schedules callbacks to run once a delay in game time or a number of frames has passed
+// Due callbacks are fired together once per frame, after input is polled and before any entities tick,
+// with frame timers firing before time timers
+// Game time follows PengEngine::time_scale, and is tracked to the millisecond
+class TimerSubsystem final : public Subsystem
+{
+	DECLARE_SUBSYSTEM(TimerSubsystem)
+
+public:
+	using callback = std::function<void()>;
+
+	static constexpr TimerHandle null_handle = { utils::HierarchicalTimerWheel<callback>::null_handle, false };
+
+	TimerSubsystem();
+
+	// ----------- Engine API -----------
+	void start() override;
+	void shutdown() override;
+	void tick(float delta_time) override;
+	// ----------------------------------
+
+	// ------------ User API ------------
+
+	// Fires once the game time reaches time, or at the next batch if it already has
+	TimerHandle schedule_at(double time, callback&& callback);
+	TimerHandle schedule_after(double delay, callback&& callback);
+
+	// Fires at the start of a frame, or at the next batch if the frame has already started
+	TimerHandle schedule_at_frame(int32_t frame, callback&& callback);
+	TimerHandle schedule_after_frames(int32_t frames, callback&& callback);
+
+	// Returns false if the timer already fired or was cancelled
+	bool cancel(TimerHandle handle);
+	[[nodiscard]] bool pending(TimerHandle handle) const noexcept;
+
+	// Game time in seconds since the subsystem started
+	[[nodiscard]] double time() const noexcept { return _time; }
+	[[nodiscard]] size_t num_pending() const noexcept;
+
+	// Stats about the last batch of timers fired
+	[[nodiscard]] const TimerStats& stats() const noexcept { return _stats; }
+	// ----------------------------------
+
+private:
+	static constexpr double ticks_per_second = 1000;
+
+	utils::HierarchicalTimerWheel<callback> _time_wheel;
+	utils::HierarchicalTimerWheel<callback> _frame_wheel;
+
+	double _time;
+	TimerStats _stats;
+};
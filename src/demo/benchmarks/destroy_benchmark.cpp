@@ -0,0 +1,147 @@
+#include "destroy_benchmark.h"
+
+#include <core/logger.h>
+#include <core/serialized_member.h>
+
+IMPLEMENT_ENTITY(demo::benchmarks::DestroyBenchmark);
+
+using namespace demo::benchmarks;
+
+DestroyBenchmark::DestroyBenchmark()
+	: Entity("DestroyBenchmark")
+	, _entity_count(10000)
+	, _children_per_entity(8)
+	, _runs(5)
+	, _run(0)
+	, _destroy_pending(false)
+	, _hierarchy_time_ms(0)
+	, _flat_time_ms(0)
+	, _max_time_ms(0)
+	, _post_tick_handle(utils::EventInterface<TickGroup>::null_handle)
+{
+	SERIALIZED_MEMBER(_entity_count);
+	SERIALIZED_MEMBER(_children_per_entity);
+	SERIALIZED_MEMBER(_runs);
+}
+
+void DestroyBenchmark::post_create()
+{
+	Entity::post_create();
+	Logger::log("Destroy benchmark starting with %d entities...", _entity_count);
+
+	// Kills queued during the standard group are flushed before its post tick event
+	_post_tick_handle = EntitySubsystem::get().post_tick_entity_group().subscribe([this](TickGroup tick_group)
+	{
+		if (tick_group == TickGroup::standard && _destroy_pending)
+		{
+			end_run();
+		}
+	});
+}
+
+void DestroyBenchmark::pre_destroy()
+{
+	Entity::pre_destroy();
+
+	if (_post_tick_handle != utils::EventInterface<TickGroup>::null_handle)
+	{
+		Logger::warning("Destroy benchmark destroyed before completing");
+		finish();
+	}
+}
+
+void DestroyBenchmark::tick(float delta_time)
+{
+	Entity::tick(delta_time);
+
+	if (_run >= _runs * 2)
+	{
+		return;
+	}
+
+	// Entities are spawned one frame and destroyed the next so that they are fully created first
+	if (_spawned.empty())
+	{
+		spawn_entities();
+	}
+	else
+	{
+		destroy_entities();
+	}
+}
+
+bool DestroyBenchmark::hierarchy_run() const noexcept
+{
+	return _run % 2 == 0;
+}
+
+void DestroyBenchmark::spawn_entities()
+{
+	_spawned.reserve(_entity_count);
+
+	for (int32_t i = 0; i < _entity_count; i++)
+	{
+		peng::weak_ptr<Entity> entity = create_entity<Entity>("DestroyTarget", TickGroup::none);
+
+		// Builds a tree rooted at the first entity where every entity has up to _children_per_entity children
+		if (hierarchy_run() && i > 0)
+		{
+			entity->set_parent(_spawned[(i - 1) / _children_per_entity]);
+		}
+
+		_spawned.push_back(entity);
+	}
+}
+
+void DestroyBenchmark::destroy_entities()
+{
+	_destroy_start = timing::clock::now();
+	_destroy_pending = true;
+
+	if (hierarchy_run())
+	{
+		_spawned.front()->destroy();
+	}
+	else
+	{
+		for (const EntityHandle& entity : _spawned)
+		{
+			entity->destroy();
+		}
+	}
+
+	_spawned.clear();
+}
+
+void DestroyBenchmark::end_run()
+{
+	const double time_ms = timing::duration_ms(timing::clock::now() - _destroy_start).count();
+	_destroy_pending = false;
+
+	if (hierarchy_run())
+	{
+		_hierarchy_time_ms += time_ms;
+	}
+	else
+	{
+		_flat_time_ms += time_ms;
+	}
+
+	_max_time_ms = std::max(_max_time_ms, time_ms);
+
+	if (++_run == _runs * 2)
+	{
+		Logger::success(
+			"Destroy benchmark complete for %d entities: hierarchy %.3fms, flat %.3fms average, %.3fms worst",
+			_entity_count, _hierarchy_time_ms / _runs, _flat_time_ms / _runs, _max_time_ms
+		);
+
+		finish();
+	}
+}
+
+void DestroyBenchmark::finish()
+{
+	EntitySubsystem::get().post_tick_entity_group().unsubscribe(_post_tick_handle);
+	_post_tick_handle = utils::EventInterface<TickGroup>::null_handle;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <core/entity.h>
+#include <utils/timing.h>
+#include <utils/event.h>
+
+namespace demo::benchmarks
+{
+	// Measures destroying a large number of entities in a single frame
+	// Alternates between destroying the root of a deep hierarchy and destroying flat entities one by one
+	class DestroyBenchmark final : public Entity
+	{
+		DECLARE_ENTITY(DestroyBenchmark);
+
+	public:
+		DestroyBenchmark();
+
+		void post_create() override;
+		void pre_destroy() override;
+		void tick(float delta_time) override;
+
+	private:
+		using listener_handle = utils::EventInterface<TickGroup>::listener_handle;
+
+		[[nodiscard]] bool hierarchy_run() const noexcept;
+
+		void spawn_entities();
+		void destroy_entities();
+		void end_run();
+		void finish();
+
+		int32_t _entity_count;
+		int32_t _children_per_entity;
+		int32_t _runs;
+
+		int32_t _run;
+		bool _destroy_pending;
+		std::vector<EntityHandle> _spawned;
+
+		double _hierarchy_time_ms;
+		double _flat_time_ms;
+		double _max_time_ms;
+
+		timing::clock::time_point _destroy_start;
+		listener_handle _post_tick_handle;
+	};
+}
@@ -0,0 +1,143 @@
+#include "job_benchmark.h"
+
+#include <atomic>
+#include <thread>
+#include <cmath>
+
+#include <core/logger.h>
+#include <core/serialized_member.h>
+#include <threading/thread_pool.h>
+#include <threading/job_system.h>
+#include <utils/timing.h>
+
+IMPLEMENT_ENTITY(demo::benchmarks::JobBenchmark);
+
+using namespace demo::benchmarks;
+
+JobBenchmark::JobBenchmark()
+	: Entity("JobBenchmark")
+	, _min_threads(1)
+	, _max_threads(64)
+	, _forks(200)
+	, _jobs_per_fork(256)
+	, _work_per_job(2000)
+	, _num_threads(0)
+{
+	SERIALIZED_MEMBER(_min_threads);
+	SERIALIZED_MEMBER(_max_threads);
+	SERIALIZED_MEMBER(_forks);
+	SERIALIZED_MEMBER(_jobs_per_fork);
+	SERIALIZED_MEMBER(_work_per_job);
+}
+
+void JobBenchmark::post_create()
+{
+	Entity::post_create();
+	Logger::log(
+		"Job benchmark starting with %d forks of %d jobs, from %d to %d threads...",
+		_forks, _jobs_per_fork, _min_threads, _max_threads
+	);
+
+	_num_threads = std::max(_min_threads, 1);
+	_results.resize(_jobs_per_fork);
+}
+
+void JobBenchmark::tick(float delta_time)
+{
+	Entity::tick(delta_time);
+
+	if (_num_threads > _max_threads)
+	{
+		return;
+	}
+
+	const double thread_pool_ms = measure_thread_pool(_num_threads);
+	const double job_system_ms = measure_job_system(_num_threads);
+
+	Logger::log(
+		"%d threads: thread pool %.3fms, job system %.3fms per fork/join (%.2fx)",
+		_num_threads, thread_pool_ms, job_system_ms, thread_pool_ms / job_system_ms
+	);
+
+	_num_threads *= 2;
+	if (_num_threads > _max_threads)
+	{
+		Logger::success("Job benchmark complete");
+	}
+}
+
+double JobBenchmark::measure_thread_pool(int32_t num_threads)
+{
+	threading::ThreadPool thread_pool(num_threads);
+	std::atomic<int32_t> pending = 0;
+
+	// The thread pool has no way to wait on jobs, so the forking thread spins until they are all done
+	auto fork_join = [&]
+	{
+		pending = _jobs_per_fork;
+		for (int32_t i = 0; i < _jobs_per_fork; i++)
+		{
+			thread_pool.schedule_job(threading::Job([this, &pending, i]
+			{
+				execute_job(i);
+				pending.fetch_sub(1, std::memory_order_release);
+			}));
+		}
+
+		while (pending.load(std::memory_order_acquire) > 0)
+		{
+			std::this_thread::yield();
+		}
+	};
+
+	// Workers are created lazily, so they are all spun up before measuring
+	fork_join();
+
+	return timing::measure_ms([&]
+	{
+		for (int32_t fork = 0; fork < _forks; fork++)
+		{
+			fork_join();
+		}
+	}) / _forks;
+}
+
+double JobBenchmark::measure_job_system(int32_t num_threads)
+{
+	threading::JobSystem job_system(num_threads - 1);
+	threading::JobCounter counter;
+
+	auto fork_join = [&]
+	{
+		for (int32_t i = 0; i < _jobs_per_fork; i++)
+		{
+			job_system.schedule(threading::Job([this, i]
+			{
+				execute_job(i);
+			}), counter);
+		}
+
+		job_system.wait(counter);
+	};
+
+	fork_join();
+
+	return timing::measure_ms([&]
+	{
+		for (int32_t fork = 0; fork < _forks; fork++)
+		{
+			fork_join();
+		}
+	}) / _forks;
+}
+
+void JobBenchmark::execute_job(int32_t index)
+{
+	double value = index;
+	for (int32_t i = 0; i < _work_per_job; i++)
+	{
+		value = std::sin(value) + 1;
+	}
+
+	_results[index].value = value;
+}
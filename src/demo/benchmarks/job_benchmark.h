@@ -0,0 +1,40 @@
+#pragma once
+
+#include <core/entity.h>
+
+namespace demo::benchmarks
+{
+	// Compares the work stealing job system against the thread pool with rounds of fork/join work
+	// Each frame measures a thread count, doubling from the minimum to the maximum number of threads
+	// The job system uses one worker fewer than the thread count as the forking thread executes jobs while it waits
+	class JobBenchmark final : public Entity
+	{
+		DECLARE_ENTITY(JobBenchmark);
+
+	public:
+		JobBenchmark();
+
+		void post_create() override;
+		void tick(float delta_time) override;
+
+	private:
+		struct alignas(64) JobResult
+		{
+			double value = 0;
+		};
+
+		[[nodiscard]] double measure_thread_pool(int32_t num_threads);
+		[[nodiscard]] double measure_job_system(int32_t num_threads);
+
+		void execute_job(int32_t index);
+
+		int32_t _min_threads;
+		int32_t _max_threads;
+		int32_t _forks;
+		int32_t _jobs_per_fork;
+		int32_t _work_per_job;
+
+		int32_t _num_threads;
+		std::vector<JobResult> _results;
+	};
+}
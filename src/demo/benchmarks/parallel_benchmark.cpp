@@ -0,0 +1,124 @@
+#include "parallel_benchmark.h"
+
+#include <cmath>
+
+#include <core/logger.h>
+#include <core/serialized_member.h>
+#include <threading/parallel.h>
+#include <utils/timing.h>
+#include <math/math.h>
+
+IMPLEMENT_ENTITY(demo::benchmarks::ParallelBenchmark);
+
+using namespace demo::benchmarks;
+using namespace math;
+
+ParallelBenchmark::ParallelBenchmark()
+	: Entity("ParallelBenchmark")
+	, _max_threads(64)
+	, _item_count(1000000)
+	, _runs(10)
+	, _num_threads(1)
+{
+	SERIALIZED_MEMBER(_max_threads);
+	SERIALIZED_MEMBER(_item_count);
+	SERIALIZED_MEMBER(_runs);
+}
+
+void ParallelBenchmark::post_create()
+{
+	Entity::post_create();
+	Logger::log(
+		"Parallel benchmark starting with %d items over %d runs, up to %d threads...",
+		_item_count, _runs, _max_threads
+	);
+
+	_items.resize(_item_count);
+	for (float& item : _items)
+	{
+		item = rand_range(0.0f, 1000.0f);
+	}
+
+	_results.resize(_item_count);
+}
+
+void ParallelBenchmark::tick(float delta_time)
+{
+	Entity::tick(delta_time);
+
+	if (_num_threads > _max_threads)
+	{
+		return;
+	}
+
+	const Timings timings = measure(_num_threads);
+	if (_num_threads == 1)
+	{
+		_single_threaded = timings;
+	}
+
+	Logger::log(
+		"%d threads: for %.3fms (%.2fx), reduce %.3fms (%.2fx), sort %.3fms (%.2fx)",
+		_num_threads,
+		timings.for_ms, _single_threaded.for_ms / timings.for_ms,
+		timings.reduce_ms, _single_threaded.reduce_ms / timings.reduce_ms,
+		timings.sort_ms, _single_threaded.sort_ms / timings.sort_ms
+	);
+
+	_num_threads *= 2;
+	if (_num_threads > _max_threads)
+	{
+		Logger::success("Parallel benchmark complete");
+	}
+}
+
+ParallelBenchmark::Timings ParallelBenchmark::measure(int32_t num_threads)
+{
+	// The thread running the benchmark executes chunks too, so needs one fewer worker
+	threading::JobSystem job_system(num_threads - 1);
+	const threading::ParallelOptions options = {
+		.name = "parallel benchmark",
+		.job_system = &job_system
+	};
+
+	Timings timings;
+	for (int32_t run = 0; run < _runs; run++)
+	{
+		timings.for_ms += timing::measure_ms([&]
+		{
+			threading::parallel_for_chunks(_items.size(), [this](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					_results[i] = std::sin(_items[i]) * std::cos(_items[i]);
+				}
+			}, options);
+		});
+
+		double sum = 0;
+		timings.reduce_ms += timing::measure_ms([&]
+		{
+			sum = threading::parallel_reduce(
+				_items, 0.0,
+				[](float item) { return std::sqrt(static_cast<double>(item)); },
+				std::plus(),
+				options
+			);
+		});
+
+		_results = _items;
+		timings.sort_ms += timing::measure_ms([&]
+		{
+			threading::parallel_sort(_results, std::ranges::less(), options);
+		});
+
+		check(std::ranges::is_sorted(_results));
+		check(sum > 0);
+	}
+
+	timings.for_ms /= _runs;
+	timings.reduce_ms /= _runs;
+	timings.sort_ms /= _runs;
+
+	return timings;
+}
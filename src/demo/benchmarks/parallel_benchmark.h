@@ -0,0 +1,39 @@
+#pragma once
+
+#include <core/entity.h>
+
+namespace demo::benchmarks
+{
+	// Measures how parallel_for, parallel_reduce and parallel_sort scale with the number of threads
+	// Each frame measures a thread count, doubling from 1 to the maximum number of threads, with speedups
+	// reported relative to the single threaded run
+	class ParallelBenchmark final : public Entity
+	{
+		DECLARE_ENTITY(ParallelBenchmark);
+
+	public:
+		ParallelBenchmark();
+
+		void post_create() override;
+		void tick(float delta_time) override;
+
+	private:
+		struct Timings
+		{
+			double for_ms = 0;
+			double reduce_ms = 0;
+			double sort_ms = 0;
+		};
+
+		[[nodiscard]] Timings measure(int32_t num_threads);
+
+		int32_t _max_threads;
+		int32_t _item_count;
+		int32_t _runs;
+
+		int32_t _num_threads;
+		Timings _single_threaded;
+		std::vector<float> _items;
+		std::vector<float> _results;
+	};
+}
@@ -0,0 +1,115 @@
+#include "pipeline_benchmark.h"
+
+#include <core/logger.h>
+#include <core/peng_engine.h>
+#include <core/serialized_member.h>
+
+IMPLEMENT_ENTITY(demo::benchmarks::PipelineBenchmark);
+
+using namespace demo::benchmarks;
+
+PipelineBenchmark::PipelineBenchmark()
+	: Entity("PipelineBenchmark")
+	, _frames_per_run(300)
+	, _warmup_frames(10)
+	, _runs(5)
+	, _run(0)
+	, _frame(0)
+	, _initial_frame_latency(0)
+	, _serial_time_ms(0)
+	, _pipelined_time_ms(0)
+	, _main_wait_ms(0)
+	, _render_prepare_ms(0)
+	, _overlapped_frames(0)
+{
+	SERIALIZED_MEMBER(_frames_per_run);
+	SERIALIZED_MEMBER(_warmup_frames);
+	SERIALIZED_MEMBER(_runs);
+}
+
+void PipelineBenchmark::post_create()
+{
+	Entity::post_create();
+	Logger::log("Pipeline benchmark starting with %d frames per run...", _frames_per_run);
+
+	_initial_frame_latency = PengEngine::get().frame_latency();
+	PengEngine::get().set_frame_latency(0);
+}
+
+void PipelineBenchmark::pre_destroy()
+{
+	Entity::pre_destroy();
+
+	if (_run < _runs * 2)
+	{
+		Logger::warning("Pipeline benchmark destroyed before completing");
+		finish();
+	}
+}
+
+void PipelineBenchmark::tick(float delta_time)
+{
+	Entity::tick(delta_time);
+
+	if (_run >= _runs * 2)
+	{
+		return;
+	}
+
+	// Latency changes apply from the next frame, and the frames around a change aren't representative
+	if (_frame++ < _warmup_frames)
+	{
+		return;
+	}
+
+	const PengEngine& engine = PengEngine::get();
+	if (pipelined_run())
+	{
+		const FramePipelineStats& stats = engine.last_frame_pipeline_stats();
+		_pipelined_time_ms += engine.last_frametime();
+		_main_wait_ms += stats.main_wait_ms;
+		_render_prepare_ms += stats.render_prepare_ms;
+		_overlapped_frames += stats.submitted_while_ticking ? 1 : 0;
+	}
+	else
+	{
+		_serial_time_ms += engine.last_frametime();
+	}
+
+	if (_frame == _warmup_frames + _frames_per_run)
+	{
+		end_run();
+	}
+}
+
+bool PipelineBenchmark::pipelined_run() const noexcept
+{
+	return _run % 2 == 1;
+}
+
+void PipelineBenchmark::end_run()
+{
+	_frame = 0;
+
+	if (++_run == _runs * 2)
+	{
+		const double num_frames = static_cast<double>(_frames_per_run) * _runs;
+
+		Logger::success(
+			"Pipeline benchmark complete: serial %.3fms, pipelined %.3fms average frame time (%.3fms waiting, %.3fms preparing, %.1f%% submitted while ticking)",
+			_serial_time_ms / num_frames, _pipelined_time_ms / num_frames,
+			_main_wait_ms / num_frames, _render_prepare_ms / num_frames,
+			100.0 * _overlapped_frames / num_frames
+		);
+
+		finish();
+		return;
+	}
+
+	PengEngine::get().set_frame_latency(pipelined_run() ? 1 : 0);
+}
+
+void PipelineBenchmark::finish()
+{
+	PengEngine::get().set_frame_latency(_initial_frame_latency);
+}
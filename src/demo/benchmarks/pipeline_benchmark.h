@@ -0,0 +1,40 @@
+#pragma once
+
+#include <core/entity.h>
+
+namespace demo::benchmarks
+{
+	// Compares frame times with and without pipelined frames by switching the frame latency between runs
+	// Measures whatever the rest of the scene renders, so should be placed in a scene with a rendering workload
+	class PipelineBenchmark final : public Entity
+	{
+		DECLARE_ENTITY(PipelineBenchmark);
+
+	public:
+		PipelineBenchmark();
+
+		void post_create() override;
+		void pre_destroy() override;
+		void tick(float delta_time) override;
+
+	private:
+		[[nodiscard]] bool pipelined_run() const noexcept;
+
+		void end_run();
+		void finish();
+
+		int32_t _frames_per_run;
+		int32_t _warmup_frames;
+		int32_t _runs;
+
+		int32_t _run;
+		int32_t _frame;
+		int32_t _initial_frame_latency;
+
+		double _serial_time_ms;
+		double _pipelined_time_ms;
+		double _main_wait_ms;
+		double _render_prepare_ms;
+		int32_t _overlapped_frames;
+	};
+}
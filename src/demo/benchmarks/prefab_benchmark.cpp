@@ -0,0 +1,102 @@
+#include "prefab_benchmark.h"
+
+#include <filesystem>
+
+#include <core/logger.h>
+#include <core/serialized_member.h>
+#include <core/entity_factory.h>
+#include <core/prefab.h>
+#include <utils/timing.h>
+
+IMPLEMENT_ENTITY(demo::benchmarks::PrefabBenchmark);
+
+using namespace demo::benchmarks;
+
+PrefabBenchmark::PrefabBenchmark()
+	: Entity("PrefabBenchmark")
+	, _definitions_path("resources/entities/demo")
+	, _instances_per_definition(1000)
+	, _runs(5)
+	, _finished(false)
+{
+	SERIALIZED_MEMBER(_definitions_path);
+	SERIALIZED_MEMBER(_instances_per_definition);
+	SERIALIZED_MEMBER(_runs);
+}
+
+void PrefabBenchmark::tick(float delta_time)
+{
+	Entity::tick(delta_time);
+
+	if (_finished)
+	{
+		return;
+	}
+
+	_finished = true;
+	Logger::log("Prefab benchmark starting with %d instances per definition...", _instances_per_definition);
+
+	for (const auto& entry : std::filesystem::recursive_directory_iterator(_definitions_path))
+	{
+		if (entry.is_regular_file() && entry.path().extension() == ".asset")
+		{
+			run_definition(entry.path().string());
+		}
+	}
+
+	Logger::success("Prefab benchmark complete");
+}
+
+void PrefabBenchmark::run_definition(const std::string& path)
+{
+	// The archive is only loaded once so that neither path pays for reading the file
+	const Archive archive = Archive::from_disk(path);
+	const Prefab prefab(archive);
+
+	std::vector<peng::weak_ptr<Entity>> instances;
+	instances.reserve(_instances_per_definition);
+
+	double load_time_ms = 0;
+	double instantiate_time_ms = 0;
+
+	for (int32_t run = 0; run < _runs; run++)
+	{
+		const timing::clock::time_point load_start = timing::clock::now();
+		for (int32_t i = 0; i < _instances_per_definition; i++)
+		{
+			instances.push_back(EntityFactory::get().load_entity(archive));
+		}
+
+		load_time_ms += timing::duration_ms(timing::clock::now() - load_start).count();
+		destroy_instances(instances);
+		instances.clear();
+
+		const timing::clock::time_point instantiate_start = timing::clock::now();
+		instances = EntityFactory::get().instantiate(prefab, _instances_per_definition);
+
+		instantiate_time_ms += timing::duration_ms(timing::clock::now() - instantiate_start).count();
+		destroy_instances(instances);
+		instances.clear();
+	}
+
+	Logger::log(
+		"%s: load_entity %.3fms, prefab %.3fms per %d instances (%.2fx faster)",
+		path.c_str(),
+		load_time_ms / _runs,
+		instantiate_time_ms / _runs,
+		_instances_per_definition,
+		load_time_ms / instantiate_time_ms
+	);
+}
+
+void PrefabBenchmark::destroy_instances(const std::vector<peng::weak_ptr<Entity>>& instances)
+{
+	// Instances are destroyed before they are ever created, so they never run post_create or tick
+	for (const peng::weak_ptr<Entity>& instance : instances)
+	{
+		if (instance)
+		{
+			instance->destroy();
+		}
+	}
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <core/entity.h>
+
+namespace demo::benchmarks
+{
+	// Compares instantiating every entity definition in a directory through a compiled Prefab
+	// against loading it from its archive with EntityFactory::load_entity
+	// Only the time spent instantiating is measured, as both paths create identical entities
+	class PrefabBenchmark final : public Entity
+	{
+		DECLARE_ENTITY(PrefabBenchmark);
+
+	public:
+		PrefabBenchmark();
+
+		void tick(float delta_time) override;
+
+	private:
+		void run_definition(const std::string& path);
+		void destroy_instances(const std::vector<peng::weak_ptr<Entity>>& instances);
+
+		std::string _definitions_path;
+		int32_t _instances_per_definition;
+		int32_t _runs;
+
+		bool _finished;
+	};
+}
@@ -0,0 +1,123 @@
+#include "rigid_body_benchmark.h"
+
+#include <core/logger.h>
+#include <core/serialized_member.h>
+#include <components/rigid_body.h>
+#include <math/math.h>
+
+IMPLEMENT_ENTITY(demo::benchmarks::RigidBodyBenchmark);
+
+using namespace demo::benchmarks;
+using namespace components;
+using namespace math;
+
+RigidBodyBenchmark::RigidBodyBenchmark()
+	: Entity("RigidBodyBenchmark")
+	, _body_count(100000)
+	, _frames_per_pass(120)
+	, _pass(Pass::finished)
+	, _pass_frame(0)
+	, _pass_time_ms(0)
+	, _individual_time_ms(0)
+	, _restore_batched_ticking(true)
+	, _pre_tick_handle(utils::EventInterface<TickGroup>::null_handle)
+	, _post_tick_handle(utils::EventInterface<TickGroup>::null_handle)
+{
+	SERIALIZED_MEMBER(_body_count);
+	SERIALIZED_MEMBER(_frames_per_pass);
+}
+
+void RigidBodyBenchmark::post_create()
+{
+	Entity::post_create();
+	Logger::log("Rigid body benchmark starting with %d bodies...", _body_count);
+
+	for (int32_t i = 0; i < _body_count; i++)
+	{
+		// Bodies have no entity tick so that only the rigid body cost is measured
+		peng::weak_ptr<Entity> body = create_entity<Entity>("RigidBody", TickGroup::none);
+		body->add_component<RigidBody>()->velocity = Vector3f(rand_range(-1, 1), rand_range(-1, 1), rand_range(-1, 1));
+	}
+
+	_pre_tick_handle = EntitySubsystem::get().pre_tick_entity_group().subscribe([this](TickGroup tick_group)
+	{
+		if (tick_group == TickGroup::physics)
+		{
+			_group_start = timing::clock::now();
+		}
+	});
+
+	_post_tick_handle = EntitySubsystem::get().post_tick_entity_group().subscribe([this](TickGroup tick_group)
+	{
+		// The first frame of a pass is a warm up as it includes rebuilding the tickable lists
+		if (tick_group == TickGroup::physics && _pass != Pass::finished && _pass_frame > 0)
+		{
+			_pass_time_ms += timing::duration_ms(timing::clock::now() - _group_start).count();
+		}
+	});
+
+	_restore_batched_ticking = EntitySubsystem::get().batched_ticking();
+	begin_pass(Pass::individual);
+}
+
+void RigidBodyBenchmark::pre_destroy()
+{
+	Entity::pre_destroy();
+
+	if (_pass != Pass::finished)
+	{
+		Logger::warning("Rigid body benchmark destroyed before completing");
+		finish();
+	}
+}
+
+void RigidBodyBenchmark::tick(float delta_time)
+{
+	Entity::tick(delta_time);
+
+	if (_pass != Pass::finished && ++_pass_frame > _frames_per_pass)
+	{
+		end_pass();
+	}
+}
+
+void RigidBodyBenchmark::begin_pass(Pass pass)
+{
+	_pass = pass;
+	_pass_frame = -1;
+	_pass_time_ms = 0;
+
+	EntitySubsystem::get().set_batched_ticking(pass == Pass::batched);
+}
+
+void RigidBodyBenchmark::end_pass()
+{
+	const double average_ms = _pass_time_ms / _frames_per_pass;
+
+	if (_pass == Pass::individual)
+	{
+		Logger::log("Individual tick: %.3fms per frame", average_ms);
+
+		_individual_time_ms = average_ms;
+		begin_pass(Pass::batched);
+	}
+	else
+	{
+		Logger::log("Batched tick: %.3fms per frame", average_ms);
+		Logger::success(
+			"Rigid body benchmark complete, batched ticking was %.2fx faster for %d bodies",
+			_individual_time_ms / average_ms, _body_count
+		);
+
+		finish();
+	}
+}
+
+void RigidBodyBenchmark::finish()
+{
+	_pass = Pass::finished;
+
+	EntitySubsystem::get().pre_tick_entity_group().unsubscribe(_pre_tick_handle);
+	EntitySubsystem::get().post_tick_entity_group().unsubscribe(_post_tick_handle);
+	EntitySubsystem::get().set_batched_ticking(_restore_batched_ticking);
+}
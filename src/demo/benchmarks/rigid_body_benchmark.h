@@ -0,0 +1,49 @@
+#pragma once
+
+#include <core/entity.h>
+#include <utils/timing.h>
+#include <utils/event.h>
+
+namespace demo::benchmarks
+{
+	// Compares ticking rigid bodies individually through ITickable::tick against batched tick_all
+	// Each pass times the physics tick group over a number of frames and logs the average
+	class RigidBodyBenchmark final : public Entity
+	{
+		DECLARE_ENTITY(RigidBodyBenchmark);
+
+	public:
+		RigidBodyBenchmark();
+
+		void post_create() override;
+		void pre_destroy() override;
+		void tick(float delta_time) override;
+
+	private:
+		enum class Pass
+		{
+			individual,
+			batched,
+			finished
+		};
+
+		using listener_handle = utils::EventInterface<TickGroup>::listener_handle;
+
+		void begin_pass(Pass pass);
+		void end_pass();
+		void finish();
+
+		int32_t _body_count;
+		int32_t _frames_per_pass;
+
+		Pass _pass;
+		int32_t _pass_frame;
+		double _pass_time_ms;
+		double _individual_time_ms;
+		bool _restore_batched_ticking;
+
+		timing::clock::time_point _group_start;
+		listener_handle _pre_tick_handle;
+		listener_handle _post_tick_handle;
+	};
+}
@@ -0,0 +1,161 @@
+#include "schedule_benchmark.h"
+
+#include <numeric>
+
+#include <core/logger.h>
+#include <core/serialized_member.h>
+#include <components/rigid_body.h>
+#include <components/rigid_body_2d.h>
+#include <utils/strtools.h>
+#include <math/math.h>
+
+IMPLEMENT_ENTITY(demo::benchmarks::ScheduleBenchmark);
+
+using namespace demo::benchmarks;
+using namespace components;
+using namespace math;
+
+ScheduleBenchmark::ScheduleBenchmark()
+	: Entity("ScheduleBenchmark")
+	, _body_count(50000)
+	, _frames_per_pass(120)
+	, _pass(Pass::finished)
+	, _pass_frame(0)
+	, _pass_time_ms()
+	, _pass_peak_concurrency()
+	, _unscheduled_time_ms(0)
+	, _restore_scheduled_ticking(true)
+	, _pre_tick_handle(utils::EventInterface<TickGroup>::null_handle)
+	, _post_tick_handle(utils::EventInterface<TickGroup>::null_handle)
+{
+	SERIALIZED_MEMBER(_body_count);
+	SERIALIZED_MEMBER(_frames_per_pass);
+}
+
+void ScheduleBenchmark::post_create()
+{
+	Entity::post_create();
+	Logger::log("Schedule benchmark starting with %d bodies...", _body_count);
+
+	// Both kinds of body declare independent access, so their batches can be ticked alongside each other
+	for (int32_t i = 0; i < _body_count; i++)
+	{
+		peng::weak_ptr<Entity> body = create_entity<Entity>("RigidBody", TickGroup::none);
+		if (i % 2 == 0)
+		{
+			body->add_component<RigidBody>()->velocity = Vector3f(rand_range(-1, 1), rand_range(-1, 1), rand_range(-1, 1));
+		}
+		else
+		{
+			body->add_component<RigidBody2D>()->velocity = Vector2f(rand_range(-1, 1), rand_range(-1, 1));
+		}
+	}
+
+	_pre_tick_handle = EntitySubsystem::get().pre_tick_entity_group().subscribe([this](TickGroup tick_group)
+	{
+		if (measured_index(tick_group) >= 0)
+		{
+			_group_start = timing::clock::now();
+		}
+	});
+
+	_post_tick_handle = EntitySubsystem::get().post_tick_entity_group().subscribe([this](TickGroup tick_group)
+	{
+		// The first frame of a pass is a warm up as it includes rebuilding the tickable lists
+		const int32_t index = measured_index(tick_group);
+		if (index >= 0 && _pass != Pass::finished && _pass_frame > 0)
+		{
+			_pass_time_ms[index] += timing::duration_ms(timing::clock::now() - _group_start).count();
+			_pass_peak_concurrency[index] = std::max(
+				_pass_peak_concurrency[index],
+				EntitySubsystem::get().peak_scheduled_concurrency(tick_group)
+			);
+		}
+	});
+
+	_restore_scheduled_ticking = EntitySubsystem::get().scheduled_ticking();
+	begin_pass(Pass::unscheduled);
+}
+
+void ScheduleBenchmark::pre_destroy()
+{
+	Entity::pre_destroy();
+
+	if (_pass != Pass::finished)
+	{
+		Logger::warning("Schedule benchmark destroyed before completing");
+		finish();
+	}
+}
+
+void ScheduleBenchmark::tick(float delta_time)
+{
+	Entity::tick(delta_time);
+
+	if (_pass != Pass::finished && ++_pass_frame > _frames_per_pass)
+	{
+		end_pass();
+	}
+}
+
+void ScheduleBenchmark::begin_pass(Pass pass)
+{
+	_pass = pass;
+	_pass_frame = -1;
+	_pass_time_ms.fill(0);
+	_pass_peak_concurrency.fill(0);
+
+	EntitySubsystem::get().set_scheduled_ticking(pass == Pass::scheduled);
+}
+
+void ScheduleBenchmark::end_pass()
+{
+	const char* pass_name = _pass == Pass::scheduled ? "Scheduled" : "Unscheduled";
+	for (size_t i = 0; i < measured_groups.size(); i++)
+	{
+		Logger::log(
+			"%s tick, %s: %.3fms per frame with up to %d concurrent jobs",
+			pass_name, strtools::cat(measured_groups[i]).c_str(),
+			_pass_time_ms[i] / _frames_per_pass, _pass_peak_concurrency[i]
+		);
+	}
+
+	const double average_ms = std::accumulate(_pass_time_ms.begin(), _pass_time_ms.end(), 0.0) / _frames_per_pass;
+
+	if (_pass == Pass::unscheduled)
+	{
+		_unscheduled_time_ms = average_ms;
+		begin_pass(Pass::scheduled);
+	}
+	else
+	{
+		Logger::success(
+			"Schedule benchmark complete, scheduled ticking was %.2fx faster across the measured groups for %d bodies",
+			_unscheduled_time_ms / average_ms, _body_count
+		);
+
+		finish();
+	}
+}
+
+void ScheduleBenchmark::finish()
+{
+	_pass = Pass::finished;
+
+	EntitySubsystem::get().pre_tick_entity_group().unsubscribe(_pre_tick_handle);
+	EntitySubsystem::get().post_tick_entity_group().unsubscribe(_post_tick_handle);
+	EntitySubsystem::get().set_scheduled_ticking(_restore_scheduled_ticking);
+}
+
+int32_t ScheduleBenchmark::measured_index(TickGroup tick_group) noexcept
+{
+	for (size_t i = 0; i < measured_groups.size(); i++)
+	{
+		if (measured_groups[i] == tick_group)
+		{
+			return static_cast<int32_t>(i);
+		}
+	}
+
+	return -1;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <array>
+
+#include <core/entity.h>
+#include <utils/timing.h>
+#include <utils/event.h>
+
+namespace demo::benchmarks
+{
+	// Compares ticking with declared tick access honoured, where non conflicting tickables and batches are scheduled
+	// concurrently, against ticking every tickable as if undeclared
+	// Each pass times the standard, physics and parallel render tick groups and records the most scheduled jobs that
+	// ran at once in each, which shows whether the declared tickables actually overlapped
+	class ScheduleBenchmark final : public Entity
+	{
+		DECLARE_ENTITY(ScheduleBenchmark);
+
+	public:
+		ScheduleBenchmark();
+
+		void post_create() override;
+		void pre_destroy() override;
+		void tick(float delta_time) override;
+
+	private:
+		enum class Pass
+		{
+			unscheduled,
+			scheduled,
+			finished
+		};
+
+		static constexpr std::array measured_groups = {
+			TickGroup::standard,
+			TickGroup::physics,
+			TickGroup::render_parallel
+		};
+
+		using listener_handle = utils::EventInterface<TickGroup>::listener_handle;
+
+		void begin_pass(Pass pass);
+		void end_pass();
+		void finish();
+
+		[[nodiscard]] static int32_t measured_index(TickGroup tick_group) noexcept;
+
+		int32_t _body_count;
+		int32_t _frames_per_pass;
+
+		Pass _pass;
+		int32_t _pass_frame;
+		std::array<double, measured_groups.size()> _pass_time_ms;
+		std::array<int32_t, measured_groups.size()> _pass_peak_concurrency;
+		double _unscheduled_time_ms;
+		bool _restore_scheduled_ticking;
+
+		timing::clock::time_point _group_start;
+		listener_handle _pre_tick_handle;
+		listener_handle _post_tick_handle;
+	};
+}
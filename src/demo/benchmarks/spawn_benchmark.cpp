@@ -0,0 +1,156 @@
+#include "spawn_benchmark.h"
+
+#include <core/logger.h>
+#include <core/serialized_member.h>
+
+IMPLEMENT_ENTITY(demo::benchmarks::SpawnTarget);
+IMPLEMENT_ENTITY(demo::benchmarks::SpawnBenchmark);
+
+using namespace demo::benchmarks;
+
+SpawnTarget::SpawnTarget()
+	: Entity("SpawnTarget", TickGroup::none)
+{ }
+
+SpawnBenchmark::SpawnBenchmark()
+	: Entity("SpawnBenchmark")
+	, _entity_count(100000)
+	, _runs(5)
+	, _run(0)
+	, _spawn_pending(false)
+	, _bulk_time_ms(0)
+	, _individual_time_ms(0)
+	, _post_tick_handle(utils::EventInterface<TickGroup>::null_handle)
+{
+	SERIALIZED_MEMBER(_entity_count);
+	SERIALIZED_MEMBER(_runs);
+}
+
+void SpawnBenchmark::post_create()
+{
+	Entity::post_create();
+	Logger::log("Spawn benchmark starting with %d entities...", _entity_count);
+
+	// Adds queued during the standard group are flushed before its post tick event
+	_post_tick_handle = EntitySubsystem::get().post_tick_entity_group().subscribe([this](TickGroup tick_group)
+	{
+		if (tick_group == TickGroup::standard && _spawn_pending)
+		{
+			end_run();
+		}
+	});
+}
+
+void SpawnBenchmark::pre_destroy()
+{
+	Entity::pre_destroy();
+
+	if (_post_tick_handle != utils::EventInterface<TickGroup>::null_handle)
+	{
+		Logger::warning("Spawn benchmark destroyed before completing");
+		finish();
+	}
+}
+
+void SpawnBenchmark::tick(float delta_time)
+{
+	Entity::tick(delta_time);
+
+	if (_run >= _runs * 2)
+	{
+		return;
+	}
+
+	// Entities are spawned one frame and destroyed the next so that destruction isn't measured
+	if (_spawned.empty())
+	{
+		spawn_entities();
+	}
+	else
+	{
+		destroy_entities();
+	}
+}
+
+bool SpawnBenchmark::bulk_run() const noexcept
+{
+	return _run % 2 == 0;
+}
+
+void SpawnBenchmark::spawn_entities()
+{
+	_spawned.reserve(_entity_count);
+	_spawn_start = timing::clock::now();
+	_spawn_pending = true;
+
+	if (bulk_run())
+	{
+		create_entities<SpawnTarget>(_entity_count, [this](SpawnTarget& entity, size_t)
+		{
+			_spawned.push_back(entity.handle());
+		});
+	}
+	else
+	{
+		for (int32_t i = 0; i < _entity_count; i++)
+		{
+			_spawned.push_back(create_entity<SpawnTarget>());
+		}
+	}
+}
+
+void SpawnBenchmark::destroy_entities()
+{
+	for (const EntityHandle& entity : _spawned)
+	{
+		entity->destroy();
+	}
+
+	_spawned.clear();
+}
+
+void SpawnBenchmark::end_run()
+{
+	const double time_ms = timing::duration_ms(timing::clock::now() - _spawn_start).count();
+	_spawn_pending = false;
+
+	if (bulk_run())
+	{
+		_bulk_time_ms += time_ms;
+	}
+	else
+	{
+		_individual_time_ms += time_ms;
+	}
+
+	if (++_run == _runs * 2)
+	{
+		// Entities per second from the total time in milliseconds across every run
+		constexpr double target_rate = 100000;
+		const double bulk_rate = _entity_count * _runs * 1000.0 / _bulk_time_ms;
+		const double individual_rate = _entity_count * _runs * 1000.0 / _individual_time_ms;
+
+		if (bulk_rate >= target_rate)
+		{
+			Logger::success(
+				"Spawn benchmark complete for %d entities: bulk %.0f/s, individual %.0f/s",
+				_entity_count, bulk_rate, individual_rate
+			);
+		}
+		else
+		{
+			Logger::warning(
+				"Spawn benchmark complete for %d entities: bulk %.0f/s is below the target of %.0f/s, individual %.0f/s",
+				_entity_count, bulk_rate, target_rate, individual_rate
+			);
+		}
+
+		finish();
+	}
+}
+
+void SpawnBenchmark::finish()
+{
+	EntitySubsystem::get().post_tick_entity_group().unsubscribe(_post_tick_handle);
+	_post_tick_handle = utils::EventInterface<TickGroup>::null_handle;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <core/entity.h>
+#include <utils/timing.h>
+#include <utils/event.h>
+
+namespace demo::benchmarks
+{
+	// A minimal entity spawned by the spawn benchmark, which allows post_create to run in parallel
+	class SpawnTarget final : public Entity
+	{
+		DECLARE_ENTITY(SpawnTarget);
+
+	public:
+		static constexpr bool parallel_post_create = true;
+
+		SpawnTarget();
+	};
+
+	// Measures the throughput of spawning a large number of entities in a single frame
+	// Alternates between spawning with create_entities and spawning one by one with create_entity
+	// The time taken includes the flush that creates the entities
+	class SpawnBenchmark final : public Entity
+	{
+		DECLARE_ENTITY(SpawnBenchmark);
+
+	public:
+		SpawnBenchmark();
+
+		void post_create() override;
+		void pre_destroy() override;
+		void tick(float delta_time) override;
+
+	private:
+		using listener_handle = utils::EventInterface<TickGroup>::listener_handle;
+
+		[[nodiscard]] bool bulk_run() const noexcept;
+
+		void spawn_entities();
+		void destroy_entities();
+		void end_run();
+		void finish();
+
+		int32_t _entity_count;
+		int32_t _runs;
+
+		int32_t _run;
+		bool _spawn_pending;
+		std::vector<EntityHandle> _spawned;
+
+		double _bulk_time_ms;
+		double _individual_time_ms;
+
+		timing::clock::time_point _spawn_start;
+		listener_handle _post_tick_handle;
+	};
+}
@@ -0,0 +1,117 @@
+#include "timer_benchmark.h"
+
+#include <core/logger.h>
+#include <core/serialized_member.h>
+#include <utils/timing.h>
+#include <math/math.h>
+
+IMPLEMENT_ENTITY(demo::benchmarks::TimerBenchmark);
+
+using namespace demo::benchmarks;
+using namespace math;
+
+TimerBenchmark::TimerBenchmark()
+	: Entity("TimerBenchmark")
+	, _timer_count(1000000)
+	, _max_delay(10)
+	, _cancel_interval(4)
+	, _running(false)
+	, _expected_fires(0)
+	, _fired(0)
+	, _frames(0)
+	, _fire_time_ms(0)
+	, _max_fire_time_ms(0)
+{
+	SERIALIZED_MEMBER(_timer_count);
+	SERIALIZED_MEMBER(_max_delay);
+	SERIALIZED_MEMBER(_cancel_interval);
+}
+
+void TimerBenchmark::post_create()
+{
+	Entity::post_create();
+	Logger::log("Timer benchmark starting with %d timers...", _timer_count);
+
+	TimerSubsystem& timers = TimerSubsystem::get();
+	_timers.reserve(_timer_count);
+
+	const double schedule_ms = timing::measure_ms([&]
+	{
+		for (int32_t i = 0; i < _timer_count; i++)
+		{
+			_timers.push_back(timers.schedule_after(rand_range(0, _max_delay), [this]
+			{
+				_fired++;
+			}));
+		}
+	});
+
+	// Cancelling every few timers leaves holes spread across the whole wheel
+	int32_t cancelled = 0;
+	const double cancel_ms = timing::measure_ms([&]
+	{
+		for (size_t i = 0; _cancel_interval > 0 && i < _timers.size(); i += _cancel_interval)
+		{
+			cancelled += timers.cancel(_timers[i]);
+		}
+	});
+
+	_expected_fires = _timer_count - cancelled;
+	_running = true;
+
+	Logger::log(
+		"Scheduled %d timers in %.3fms (%.1fns each), cancelled %d in %.3fms (%.1fns each)",
+		_timer_count, schedule_ms, schedule_ms * 1e6 / std::max(_timer_count, 1),
+		cancelled, cancel_ms, cancel_ms * 1e6 / std::max(cancelled, 1)
+	);
+}
+
+void TimerBenchmark::pre_destroy()
+{
+	Entity::pre_destroy();
+
+	if (_running)
+	{
+		Logger::warning("Timer benchmark destroyed before completing");
+		finish();
+	}
+}
+
+void TimerBenchmark::tick(float delta_time)
+{
+	Entity::tick(delta_time);
+
+	if (!_running)
+	{
+		return;
+	}
+
+	// Timers fire in a batch before entities tick, so the stats are for the current frame
+	const TimerStats& stats = TimerSubsystem::get().stats();
+	_fire_time_ms += stats.fire_time_ms;
+	_max_fire_time_ms = std::max(_max_fire_time_ms, stats.fire_time_ms);
+	_frames++;
+
+	if (_fired >= _expected_fires)
+	{
+		Logger::success(
+			"Timer benchmark complete, fired %d timers over %d frames: %.3fms average, %.3fms worst per frame",
+			_fired, _frames, _fire_time_ms / _frames, _max_fire_time_ms
+		);
+
+		finish();
+	}
+}
+
+void TimerBenchmark::finish()
+{
+	_running = false;
+
+	// Cancelling timers that already fired is a no op
+	for (const TimerHandle& timer : _timers)
+	{
+		TimerSubsystem::get().cancel(timer);
+	}
+
+	_timers.clear();
+}
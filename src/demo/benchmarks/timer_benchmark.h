@@ -0,0 +1,36 @@
+#pragma once
+
+#include <core/entity.h>
+#include <core/timer_subsystem.h>
+
+namespace demo::benchmarks
+{
+	// Measures the timer subsystem with a large number of pending timers
+	// Times scheduling and cancelling the timers, and the cost of each frame's batch until every timer has fired
+	class TimerBenchmark final : public Entity
+	{
+		DECLARE_ENTITY(TimerBenchmark);
+
+	public:
+		TimerBenchmark();
+
+		void post_create() override;
+		void pre_destroy() override;
+		void tick(float delta_time) override;
+
+	private:
+		void finish();
+
+		int32_t _timer_count;
+		float _max_delay;
+		int32_t _cancel_interval;
+
+		bool _running;
+		int32_t _expected_fires;
+		int32_t _fired;
+		int32_t _frames;
+		double _fire_time_ms;
+		double _max_fire_time_ms;
+		std::vector<TimerHandle> _timers;
+	};
+}
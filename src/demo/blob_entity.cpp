@@ -27,7 +27,7 @@ BlobEntity::BlobEntity(
 	peng::shared_ref<Material> material = peng::make_shared<Material>(shader);
 	material->set_parameter("color_tex", wall_texture.load());
 
-	_local_transform = Transform(Vector3f(pos, pos.y + 2), Vector3f::one(), Vector3f::zero());
+	local_transform() = Transform(Vector3f(pos, pos.y + 2), Vector3f::one(), Vector3f::zero());
 	_mesh_renderer = add_component<MeshRenderer>(mesh, material);
 }
 
@@ -65,7 +65,7 @@ void BlobEntity::tick(float delta_time)
 	if (InputSubsystem::get()[KeyCode::o].is_down()) { rotation.z += 1; }
 	if (InputSubsystem::get()[KeyCode::l].is_down()) { rotation.z -= 1; }
 
-	_local_transform.rotation += rotation * 90 * delta_time;
+	local_transform().rotation += rotation * 90 * delta_time;
 
 	_age += delta_time;
 	_mesh_renderer->material()->set_parameter("time", _age);
@@ -1,8 +1,12 @@
 #include "debug_entity.h"
 
 #include <core/peng_engine.h>
+#include <memory/gc.h>
+#include <memory/frame_arena.h>
+#include <memory/block_pool.h>
 #include <input/input_subsystem.h>
 #include <rendering/window_subsystem.h>
+#include <rendering/render_queue.h>
 
 IMPLEMENT_ENTITY(demo::DebugEntity);
 
@@ -19,6 +23,62 @@ void DebugEntity::tick(float delta_time)
 		EntitySubsystem::get().dump_hierarchy();
 	}
 
+	if (InputSubsystem::get()[KeyCode::num_row_9].pressed())
+	{
+		const TickStats& stats = EntitySubsystem::get().tick_stats();
+		Logger::log(
+			"Tick stats: %d tickables, %d scheduled, %d batched components, %d throttled, %d skipped",
+			stats.tickables, stats.scheduled_tickables, stats.batched_components, stats.throttled_tickables,
+			stats.skipped_tickables
+		);
+	}
+
+	if (InputSubsystem::get()[KeyCode::num_row_8].pressed())
+	{
+		const memory::GCStats& stats = memory::GC::get().stats();
+		Logger::log(
+			"GC stats: %d tracked, %d dead, %d pending garbage, %d scanned in %.3fms, %d freed in %.3fms",
+			stats.tracked_objects, stats.dead_objects, stats.pending_garbage,
+			stats.scanned_objects, stats.scan_time_ms, stats.freed_objects, stats.free_time_ms
+		);
+	}
+
+	if (InputSubsystem::get()[KeyCode::num_row_7].pressed())
+	{
+		const memory::FrameArenaStats& stats = memory::FrameArena::get().stats();
+		Logger::log(
+			"Frame arena stats: %zu bytes used, %zu peak, %zu reserved across %d threads, %d overflow blocks",
+			stats.bytes_used, stats.peak_bytes_used, stats.bytes_reserved, stats.thread_arenas, stats.overflow_blocks
+		);
+	}
+
+	if (InputSubsystem::get()[KeyCode::num_row_6].pressed())
+	{
+		for (const memory::PoolStats& stats : memory::BlockPool::all_stats())
+		{
+			Logger::log(
+				"Pool stats for %s: %zu of %zu blocks of %zu bytes in %zu chunks, %zu peak, %.1f%% occupied, %.1f%% fragmented",
+				stats.name, stats.allocated_blocks, stats.capacity, stats.block_size, stats.num_chunks,
+				stats.peak_allocated_blocks, stats.occupancy * 100, stats.fragmentation * 100
+			);
+		}
+	}
+
+	if (InputSubsystem::get()[KeyCode::num_row_5].pressed())
+	{
+		const FramePipelineStats& stats = PengEngine::get().last_frame_pipeline_stats();
+		Logger::log(
+			"Frame pipeline stats: latency %d, main waited %.3fms, render waited %.3fms, render prepared in %.3fms",
+			PengEngine::get().frame_latency(), stats.main_wait_ms, stats.render_wait_ms, stats.render_prepare_ms
+		);
+
+		const rendering::RenderQueueStats& queue_stats = rendering::RenderQueue::get().last_frame_stats();
+		Logger::log(
+			"Sprites prepared in %.3fms with a critical path of %.3fms",
+			queue_stats.sprite_prepare_ms, queue_stats.sprite_critical_path_ms
+		);
+	}
+
 	if (InputSubsystem::get()[KeyCode::f11].pressed())
 	{
 		WindowSubsystem::get().toggle_fullscreen();
@@ -1,10 +1,11 @@
 #include "gravity_controller.h"
 
 #include <algorithm>
-#include <execution>
 
 #include <core/peng_engine.h>
+#include <core/tick_access.h>
 #include <profiling/scoped_event.h>
+#include <threading/parallel.h>
 #include <entities/skybox.h>
 #include <rendering/texture.h>
 #include <rendering/material.h>
@@ -45,27 +46,16 @@ void GravityController::tick(float delta_time)
 	SCOPED_EVENT("GravityController - tick");
 	Entity::tick(delta_time);
 
-	// Accessing via weak-ptr is quite slow due to thread safety so cache raw ptrs
-	std::vector<Rock*> rock_ptrs;
-
-	{
-		SCOPED_EVENT("GravityController - cache pointers");
-
-		rock_ptrs.reserve(_rocks.size());
-		for (auto& rock : _rocks)
-		{
-			rock_ptrs.push_back(rock.lock().get());
-		}
-	}
-
 	{
 		SCOPED_EVENT("GravityController - apply attraction");
 
-		std::for_each(
-			std::execution::par_unseq, rock_ptrs.begin(), rock_ptrs.end(),
-			[&](Rock* rock1) {
-				for (Rock* rock2 : rock_ptrs)
+		threading::parallel_for(
+			_rocks,
+			[&](const Handle<Rock>& rock1_handle) {
+				Rock* rock1 = rock1_handle.get();
+				for (const Handle<Rock>& rock2_handle : _rocks)
 				{
+					const Rock* rock2 = rock2_handle.get();
 					if (rock1 != rock2)
 					{
 						constexpr float gravity_strength = 20.0f;
@@ -82,30 +72,42 @@ void GravityController::tick(float delta_time)
 						}
 					}
 				}
-			});
+			},
+			{ .name = "apply attraction" });
 	}
 }
 
+const TickAccess* GravityController::tick_access() const noexcept
+{
+	// Attraction reads the cached positions of every rock and writes their velocities
+	static const TickAccess access = TickAccess("GravityController")
+		.reads<Entity>()
+		.writes<Rock>();
+
+	return &access;
+}
+
 void GravityController::create_rock_field(int32_t count, float radius, float speed)
 {
 	SCOPED_EVENT("GravityController - create rock field", strtools::catf_temp("%d rocks", count));
-	for (int32_t i = 0; i < count; i++)
-	{
-		auto rock = create_entity<Rock>(strtools::catf("Rock#%d", i));
+	_rocks.reserve(_rocks.size() + count);
 
-		rock->mass = rand_range(0.001f, 0.05f);
-		rock->local_transform().position = Vector3f(
+	const std::string rock_name = "Rock";
+	create_entities<Rock>(count, [&](Rock& rock, size_t)
+	{
+		rock.mass = rand_range(0.001f, 0.05f);
+		rock.local_transform().position = Vector3f(
 			rand_range(-radius, radius),
 			rand_range(-radius, radius),
 			rand_range(-radius, radius)
 		);
 
-		rock->velocity = Vector3f(
+		rock.velocity = Vector3f(
 			rand_range(-speed, speed),
 			rand_range(-speed, speed),
 			rand_range(-speed, speed)
 		);
 
-		_rocks.push_back(rock);
-	}
+		_rocks.push_back(rock.handle());
+	}, rock_name);
 }
@@ -15,10 +15,11 @@ namespace demo::gravity
 
 		void post_create() override;
 		void tick(float delta_time) override;
+		[[nodiscard]] const TickAccess* tick_access() const noexcept override;
 
 	private:
 		void create_rock_field(int32_t count, float radius, float speed);
 
-		std::vector<peng::weak_ptr<Rock>> _rocks;
+		std::vector<Handle<Rock>> _rocks;
 	};
 }
@@ -1,6 +1,7 @@
 #include "rock.h"
 
 #include <math/math.h>
+#include <core/tick_access.h>
 #include <components/mesh_renderer.h>
 #include <rendering/material.h>
 #include <rendering/primitives.h>
@@ -26,8 +27,18 @@ void Rock::tick(float delta_time)
 
 	_radius = std::powf(mass, 0.33f) * scale;
 
-	_local_transform.scale = math::Vector3f::one() * _radius;
-	_local_transform.position += velocity * delta_time;
+	local_transform().scale = math::Vector3f::one() * _radius;
+	local_transform().position += velocity * delta_time;
+}
+
+const TickAccess* Rock::tick_access() const noexcept
+{
+	// Rocks only move themselves, but read the velocity that the gravity controller writes
+	static const TickAccess access = TickAccess("Rock")
+		.reads<Rock>()
+		.independent();
+
+	return &access;
 }
 
 float Rock::radius() const noexcept
@@ -13,6 +13,7 @@ namespace demo::gravity
 
 		void post_create() override;
 		void tick(float delta_time) override;
+		[[nodiscard]] const TickAccess* tick_access() const noexcept override;
 
 		[[nodiscard]] float radius() const noexcept;
 
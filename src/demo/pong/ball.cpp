@@ -22,8 +22,10 @@ using namespace math;
 Ball::Ball()
 	: Entity("Ball")
 	, _speed(50)
+	, _serve_delay(1)
 {
 	SERIALIZED_MEMBER(_speed);
+	SERIALIZED_MEMBER(_serve_delay);
 	SERIALIZED_MEMBER(_bounce_wall_sfx);
 	SERIALIZED_MEMBER(_bounce_paddle_sfx);
 	SERIALIZED_MEMBER(_goal_sfx);
@@ -34,27 +36,36 @@ Ball::Ball()
 	peng::weak_ptr<BoxCollider2D> collider = add_component<BoxCollider2D>();
 	collider->triggers_enabled = true;
 	collider->layer = physics::Layer(2);
-	collider->on_trigger_enter().subscribe([this](const peng::weak_ptr<Collider2D>& collider)
+	collider->on_trigger_enter().subscribe([this](const Handle<Collider2D>& collider)
 		{
 			handle_collision(collider);
 		});
 
-	_local_transform.scale = Vector3f(1, 1, 1);
-	respawn();
+	local_transform().scale = Vector3f(1, 1, 1);
 }
 
-void Ball::respawn()
+void Ball::post_create()
 {
+	Entity::post_create();
+	_serve_script = start_script(serve());
+}
+
+Script Ball::serve()
+{
+	get_component<RigidBody2D>()->velocity = Vector2f::zero();
+	local_transform().position = Vector3f::zero();
+
+	co_await seconds(_serve_delay);
+
 	const float angle = rand_range(-1, 1);
 	const Vector2f dir = Vector2f(std::cos(angle), std::sin(angle));
 	const Vector2f reflector = Vector2f(rand() % 2 ? -1 : 1, 1);
 	const Vector2f velocity = dir * reflector * _speed * 0.75f;
 
 	get_component<RigidBody2D>()->velocity = velocity;
-	_local_transform.position = Vector3f::zero();
 }
 
-void Ball::handle_collision(peng::weak_ptr<Collider2D> collider)
+void Ball::handle_collision(const Handle<Collider2D>& collider)
 {
 	const physics::AABB box = collider->bounding_box();
 	const Vector3f delta = box.center - world_position();
@@ -68,7 +79,13 @@ void Ball::handle_collision(peng::weak_ptr<Collider2D> collider)
 			_audio_pool.play(_goal_sfx.to_shared_ref());
 		}
 
-		respawn();
+		// Restarts the serve rather than overlapping it with one still holding the ball
+		if (_serve_script)
+		{
+			stop_script(*_serve_script);
+		}
+
+		_serve_script = start_script(serve());
 	}
 	else if (peng::weak_ptr<const Paddle> paddle = collider->owner().as_type<Paddle>())
 	{
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <optional>
+
 #include <core/entity.h>
 #include <audio/audio_pool.h>
 
@@ -22,11 +24,16 @@ namespace demo::pong
 	public:
 		Ball();
 
+		void post_create() override;
+
 	private:
-		void respawn();
-		void handle_collision(peng::weak_ptr<components::Collider2D> collider);
+		// Holds the ball in the center for the serve delay before launching it
+		Script serve();
+		void handle_collision(const Handle<components::Collider2D>& collider);
 
 		float _speed;
+		float _serve_delay;
+		std::optional<ScriptId> _serve_script;
 		peng::shared_ptr<const audio::AudioClip> _bounce_wall_sfx;
 		peng::shared_ptr<const audio::AudioClip> _bounce_paddle_sfx;
 		peng::shared_ptr<const audio::AudioClip> _goal_sfx;
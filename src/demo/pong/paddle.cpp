@@ -22,12 +22,12 @@ Paddle::Paddle(const std::string& name)
 	peng::weak_ptr<Collider2D> collider = add_component<BoxCollider2D>();
 	collider->triggers_enabled = true;
 	collider->layer = physics::Layer(1);
-	collider->on_trigger_stay().subscribe([this](peng::weak_ptr<Collider2D> other)
+	collider->on_trigger_stay().subscribe([this](const Handle<Collider2D>& other)
 		{
 			handle_collision(other);
 		});
 
-	_local_transform.scale = Vector3f(1, 7, 1);
+	local_transform().scale = Vector3f(1, 7, 1);
 }
 
 void Paddle::tick(float delta_time)
@@ -44,7 +44,7 @@ void Paddle::score_point()
 	_on_score_changed(_score);
 }
 
-void Paddle::handle_collision(peng::weak_ptr<Collider2D> collider)
+void Paddle::handle_collision(const Handle<Collider2D>& collider)
 {
 	if (collider->layer == physics::Layer(0))
 	{
@@ -54,7 +54,7 @@ void Paddle::handle_collision(peng::weak_ptr<Collider2D> collider)
 		const Vector3f dist = other_aabb.center - aabb.center;
 		const Vector3f desired_dist = other_aabb.size + aabb.size;
 
-		_local_transform.position.y = (other_aabb.center - desired_dist * sgn(dist.y)).y;
+		local_transform().position.y = (other_aabb.center - desired_dist * sgn(dist.y)).y;
 		get_component<RigidBody2D>()->velocity = Vector2f::zero();
 	}
 }
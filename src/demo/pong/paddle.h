@@ -24,7 +24,7 @@ namespace demo::pong
 		float attack_arc = 90;
 
 	private:
-		void handle_collision(peng::weak_ptr<components::Collider2D> collider);
+		void handle_collision(const Handle<components::Collider2D>& collider);
 
 		int32_t _score = 0;
 	};
@@ -17,7 +17,7 @@ void PauseMenu::post_create()
 {
     Entity::post_create();
 
-    _local_transform.position = Vector3f(0, 0, -5);
+    local_transform().position = Vector3f(0, 0, -5);
 
 	peng::weak_ptr<Entity> background = create_child<Entity>("Background");
 	background->local_transform().position = Vector3f(0, 0, 1);
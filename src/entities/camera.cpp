@@ -1,9 +1,13 @@
 #include "camera.h"
 
 #include <numbers>
+#include <utility>
 
 #include <core/logger.h>
 #include <core/serialized_member.h>
+#include <core/tick_access.h>
+#include <core/entity_subsystem.h>
+#include <core/entity_command_buffer.h>
 #include <rendering/window_subsystem.h>
 #include <utils/utils.h>
 
@@ -13,7 +17,7 @@ using namespace entities;
 using namespace rendering;
 using namespace math;
 
-peng::weak_ptr<Camera> Camera::_current;
+Handle<Camera> Camera::_current;
 
 Camera::Camera()
 	: Camera("Camera")
@@ -42,7 +46,7 @@ Camera::Camera(std::string&& name)
 	SERIALIZED_MEMBER(_projection);
 }
 
-const peng::weak_ptr<Camera>& Camera::current()
+const Handle<Camera>& Camera::current()
 {
 	return _current;
 }
@@ -56,7 +60,7 @@ void Camera::post_create()
 		Logger::warning("Camera entity created when a valid camera already exists");
 	}
 
-	_current = weak_this();
+	_current = handle();
 	check(_current);
 }
 
@@ -74,6 +78,18 @@ void Camera::tick(float delta_time)
 	_view_matrix = calc_projection_matrix() * transform_inv;
 }
 
+const TickAccess* Camera::tick_access() const noexcept
+{
+	// Only the camera's own view matrix is written, which isn't read until rendering
+	// Its transform is only ever read, with any repairs to it deferred to the next flush
+	static const TickAccess access = TickAccess("Camera")
+		.reads<Entity>()
+		.reads<WindowSubsystem>()
+		.independent();
+
+	return &access;
+}
+
 void Camera::make_perspective(float fov, float near_clip, float far_clip)
 {
 	_projection = Projection::perspective;
@@ -159,15 +175,19 @@ Matrix4x4f Camera::calc_projection_matrix()
 		ortho_transform.position = Vector3f(0, 0, _near_clip);
 		ortho_transform.scale = Vector3f(effective_ortho_size * aspect_ratio, effective_ortho_size, _far_clip - _near_clip);
 
-		Vector3f& scale = _local_transform.scale;
-		if (scale.x * scale.y * scale.z == 0.0f)
+		// The camera ticks in parallel with entities that read it, so a broken scale is repaired through a deferred command
+		// rather than written here. Its cached matrices are left untouched until then
+		const Transform& transform = std::as_const(*this).local_transform();
+		if (transform.scale.x * transform.scale.y * transform.scale.z == 0.0f)
 		{
 			Logger::warning(
 				"Camera scale of (%f, %f, %f) is invalid - reverting to (1, 1, 1)",
-				scale.x, scale.y, scale.z
+				transform.scale.x, transform.scale.y, transform.scale.z
 			);
 
-			scale = Vector3f::one();
+			Transform repaired = transform;
+			repaired.scale = Vector3f::one();
+			EntitySubsystem::get().commands().set_local_transform(handle(), repaired);
 		}
 
 		return ortho_transform.to_inverse_matrix();
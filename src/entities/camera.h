@@ -28,10 +28,11 @@ namespace entities
 		explicit Camera(const std::string& name);
 		explicit Camera(std::string&& name);
 
-		static const peng::weak_ptr<Camera>& current();
+		static const Handle<Camera>& current();
 
 		void post_create() override;
 		void tick(float delta_time) override;
+		[[nodiscard]] const TickAccess* tick_access() const noexcept override;
 
 		void make_perspective(float fov, float near_clip, float far_clip);
 		void make_orthographic(float ortho_size, float near_clip, float far_clip);
@@ -48,7 +49,7 @@ namespace entities
 		[[nodiscard]] Projection projection() const noexcept;
 
 	private:
-		static peng::weak_ptr<Camera> _current;
+		static Handle<Camera> _current;
 
 		void validate_config() const noexcept;
 		[[nodiscard]] math::Matrix4x4f calc_projection_matrix();
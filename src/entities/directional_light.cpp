@@ -16,7 +16,7 @@ namespace entities
 
 using namespace entities;
 
-peng::weak_ptr<DirectionalLight> DirectionalLight::_current;
+Handle<DirectionalLight> DirectionalLight::_current;
 
 DirectionalLight::DirectionalLight()
 	: DirectionalLight("DirectionalLight")
@@ -36,7 +36,7 @@ DirectionalLight::DirectionalLight(std::string&& name)
 	SERIALIZED_MEMBER(_data);
 }
 
-const peng::weak_ptr<DirectionalLight>& DirectionalLight::current()
+const Handle<DirectionalLight>& DirectionalLight::current()
 {
 	return _current;
 }
@@ -50,7 +50,7 @@ void DirectionalLight::post_create()
 		Logger::warning("Only one directional light can be used at a time");
 	}
 
-	_current = weak_this();
+	_current = handle();
 	check(_current);
 }
 
@@ -20,7 +20,7 @@ namespace entities
 		explicit DirectionalLight(const std::string& name);
 		explicit DirectionalLight(std::string&& name);
 
-		static const peng::weak_ptr<DirectionalLight>& current();
+		static const Handle<DirectionalLight>& current();
 
 		void post_create() override;
 
@@ -28,7 +28,7 @@ namespace entities
 		[[nodiscard]] const LightData& data() const noexcept;
 
 	private:
-		static peng::weak_ptr<DirectionalLight> _current;
+		static Handle<DirectionalLight> _current;
 
 		LightData _data;
 	};
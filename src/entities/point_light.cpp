@@ -16,7 +16,7 @@ namespace entities
 
 using namespace entities;
 
-std::vector<peng::weak_ptr<PointLight>> PointLight::_active_lights;
+std::vector<Handle<PointLight>> PointLight::_active_lights;
 
 PointLight::PointLight()
 	: PointLight("PointLight")
@@ -37,7 +37,7 @@ PointLight::PointLight(std::string&& name)
 	SERIALIZED_MEMBER(_data);
 }
 
-const std::vector<peng::weak_ptr<PointLight>>& PointLight::active_lights()
+const std::vector<Handle<PointLight>>& PointLight::active_lights()
 {
 	return _active_lights;
 }
@@ -46,14 +46,14 @@ void PointLight::post_create()
 {
 	Entity::post_create();
 
-	_active_lights.push_back(weak_this());
+	_active_lights.push_back(handle());
 }
 
 void PointLight::pre_destroy()
 {
 	Entity::pre_destroy();
 
-	vectools::remove(_active_lights, weak_this());
+	vectools::remove(_active_lights, handle());
 }
 
 PointLight::LightData& PointLight::data() noexcept
@@ -20,7 +20,7 @@ namespace entities
 		explicit PointLight(const std::string& name);
 		explicit PointLight(std::string&& name);
 
-		static const std::vector<peng::weak_ptr<PointLight>>& active_lights();
+		static const std::vector<Handle<PointLight>>& active_lights();
 
 		void post_create() override;
 		void pre_destroy() override;
@@ -29,7 +29,7 @@ namespace entities
 		[[nodiscard]] const LightData& data() const noexcept;
 
 	private:
-		static std::vector<peng::weak_ptr<PointLight>> _active_lights;
+		static std::vector<Handle<PointLight>> _active_lights;
 
 		LightData _data;
 	};
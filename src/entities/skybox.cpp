@@ -21,7 +21,7 @@ void Skybox::tick(float delta_time)
 {
 	Entity::tick(delta_time);
 
-	peng::weak_ptr<Camera> camera = Camera::current();
+	const Handle<Camera> camera = Camera::current();
 	if (!camera)
 	{
 		return;
@@ -31,12 +31,17 @@ void Skybox::tick(float delta_time)
 	const Matrix4x4f view_matrix = camera->view_matrix();
 	const Matrix4x4f view_matrix_shifted = view_matrix * Matrix4x4f::from_translation(camera->world_position());
 
-	// TODO: cache parameter name
-	_material->set_parameter("view_matrix", view_matrix_shifted);
+	// TODO: cache parameter location
+	DrawUniforms uniforms;
+	if (const GLint location = _material->shader()->get_uniform_location("view_matrix"); location >= 0)
+	{
+		uniforms.emplace_back(location, view_matrix_shifted);
+	}
 
 	RenderQueue::get().enqueue_command(DrawCall{
 		.mesh = _mesh,
-		.material = _material
+		.material = _material,
+		.uniforms = std::move(uniforms)
 	});
 }
 
@@ -18,7 +18,7 @@ namespace entities
 
 using namespace entities;
 
-std::vector<peng::weak_ptr<SpotLight>> SpotLight::_active_lights;
+std::vector<Handle<SpotLight>> SpotLight::_active_lights;
 
 SpotLight::SpotLight()
 	: SpotLight("SpotLight")
@@ -39,7 +39,7 @@ SpotLight::SpotLight(std::string&& name)
 	SERIALIZED_MEMBER(_data);
 }
 
-const std::vector<peng::weak_ptr<SpotLight>>& SpotLight::active_lights()
+const std::vector<Handle<SpotLight>>& SpotLight::active_lights()
 {
 	return _active_lights;
 }
@@ -48,14 +48,14 @@ void SpotLight::post_create()
 {
 	Entity::post_create();
 
-	_active_lights.push_back(weak_this());
+	_active_lights.push_back(handle());
 }
 
 void SpotLight::pre_destroy()
 {
 	Entity::pre_destroy();
 
-	vectools::remove(_active_lights, weak_this());
+	vectools::remove(_active_lights, handle());
 }
 
 SpotLight::LightData& SpotLight::data() noexcept
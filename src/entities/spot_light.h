@@ -28,7 +28,7 @@ namespace entities
 		explicit SpotLight(const std::string& name);
 		explicit SpotLight(std::string&& name);
 
-		static const std::vector<peng::weak_ptr<SpotLight>>& active_lights();
+		static const std::vector<Handle<SpotLight>>& active_lights();
 
 		void post_create() override;
 		void pre_destroy() override;
@@ -37,7 +37,7 @@ namespace entities
 		[[nodiscard]] const LightData& data() const noexcept;
 
 	private:
-		static std::vector<peng::weak_ptr<SpotLight>> _active_lights;
+		static std::vector<Handle<SpotLight>> _active_lights;
 
 		LightData _data;
 	};
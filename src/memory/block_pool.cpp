@@ -0,0 +1,195 @@
+#include "block_pool.h"
+
+#include <new>
+#include <algorithm>
+
+#include <utils/check.h>
+
+using namespace memory;
+
+namespace
+{
+    // Pools are leaked, so the registry is too in order to outlive them
+    std::mutex& pools_mutex()
+    {
+        static std::mutex& mutex = *new std::mutex();
+        return mutex;
+    }
+
+    std::vector<const BlockPool*>& pools()
+    {
+        static std::vector<const BlockPool*>& pools = *new std::vector<const BlockPool*>();
+        return pools;
+    }
+}
+
+BlockPool::BlockPool(const char* name)
+    : _name(name)
+    , _block_size(0)
+    , _alignment(0)
+    , _reserve_hint(0)
+    , _num_free(0)
+    , _capacity(0)
+    , _peak_allocated(0)
+    , _free_list(nullptr)
+{
+    std::lock_guard lock(pools_mutex());
+    pools().push_back(this);
+}
+
+void* BlockPool::allocate(size_t block_size, size_t alignment)
+{
+    std::lock_guard lock(_mutex);
+
+    if (_block_size == 0)
+    {
+        // Every block must be large and aligned enough to hold a free list node
+        _block_size = std::max(block_size, sizeof(FreeBlock));
+        _alignment = std::max(alignment, alignof(FreeBlock));
+        _block_size = (_block_size + _alignment - 1) / _alignment * _alignment;
+    }
+
+    check(block_size <= _block_size && alignment <= _alignment);
+
+    if (!_free_list)
+    {
+        // Grow geometrically so that the number of chunks stays logarithmic
+        constexpr size_t min_chunk_blocks = 64;
+        grow(std::max({ _reserve_hint, _capacity, min_chunk_blocks }));
+        _reserve_hint = 0;
+    }
+
+    FreeBlock* block = _free_list;
+    _free_list = block->next;
+    _num_free--;
+    _peak_allocated = std::max(_peak_allocated, _capacity - _num_free);
+
+    return block;
+}
+
+void BlockPool::deallocate(void* block) noexcept
+{
+    if (!block)
+    {
+        return;
+    }
+
+    std::lock_guard lock(_mutex);
+
+    FreeBlock* free_block = static_cast<FreeBlock*>(block);
+    free_block->next = _free_list;
+    _free_list = free_block;
+    _num_free++;
+}
+
+void BlockPool::reserve(size_t count)
+{
+    std::lock_guard lock(_mutex);
+
+    if (_block_size == 0)
+    {
+        _reserve_hint = std::max(_reserve_hint, count);
+    }
+    else if (_num_free < count)
+    {
+        grow(count - _num_free);
+    }
+}
+
+size_t BlockPool::num_allocated() const noexcept
+{
+    std::lock_guard lock(_mutex);
+    return _capacity - _num_free;
+}
+
+size_t BlockPool::capacity() const noexcept
+{
+    std::lock_guard lock(_mutex);
+    return _capacity;
+}
+
+PoolStats BlockPool::stats() const
+{
+    std::lock_guard lock(_mutex);
+
+    PoolStats stats = {
+        .name = _name,
+        .block_size = _block_size,
+        .num_chunks = _chunks.size(),
+        .capacity = _capacity,
+        .allocated_blocks = _capacity - _num_free,
+        .peak_allocated_blocks = _peak_allocated
+    };
+
+    if (_capacity == 0)
+    {
+        return stats;
+    }
+
+    stats.occupancy = static_cast<double>(stats.allocated_blocks) / _capacity;
+
+    // Chunks are in allocation order rather than address order, so sort them to find which chunk a block is in
+    std::vector<Chunk> chunks = _chunks;
+    std::ranges::sort(chunks, std::less(), &Chunk::memory);
+
+    std::vector<size_t> free_per_chunk(chunks.size(), 0);
+    for (const FreeBlock* block = _free_list; block; block = block->next)
+    {
+        const std::byte* address = reinterpret_cast<const std::byte*>(block);
+        const auto it = std::ranges::upper_bound(chunks, address, std::less(), &Chunk::memory);
+        check(it != chunks.begin());
+
+        free_per_chunk[std::distance(chunks.begin(), it) - 1]++;
+    }
+
+    size_t scattered_free = 0;
+    for (size_t i = 0; i < chunks.size(); i++)
+    {
+        if (free_per_chunk[i] < chunks[i].num_blocks)
+        {
+            scattered_free += free_per_chunk[i];
+        }
+    }
+
+    if (_num_free > 0)
+    {
+        stats.fragmentation = static_cast<double>(scattered_free) / _num_free;
+    }
+
+    return stats;
+}
+
+std::vector<PoolStats> BlockPool::all_stats()
+{
+    std::lock_guard lock(pools_mutex());
+
+    std::vector<PoolStats> stats;
+    stats.reserve(pools().size());
+
+    for (const BlockPool* pool : pools())
+    {
+        stats.push_back(pool->stats());
+    }
+
+    return stats;
+}
+
+void BlockPool::grow(size_t count)
+{
+    std::byte* chunk = static_cast<std::byte*>(::operator new(count * _block_size, std::align_val_t(_alignment)));
+    _chunks.push_back(Chunk{
+        .memory = chunk,
+        .num_blocks = count
+    });
+
+    // Link the blocks in address order so that consecutive allocations are contiguous
+    for (size_t i = count; i > 0; i--)
+    {
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + (i - 1) * _block_size);
+        block->next = _free_list;
+        _free_list = block;
+    }
+
+    _num_free += count;
+    _capacity += count;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <mutex>
+#include <vector>
+#include <cstddef>
+#include <typeinfo>
+
+#include "pool_stats.h"
+
+namespace memory
+{
+    // A free list of fixed size blocks carved out of large chunks
+    // The block size is fixed by the first allocation, and blocks may be freed from any thread
+    // Chunks are never released, so that blocks can safely be freed during static destruction
+    // Every pool is registered under its name so that the stats of all pools can be inspected together
+    class BlockPool
+    {
+    public:
+        explicit BlockPool(const char* name);
+        BlockPool(const BlockPool&) = delete;
+        BlockPool(BlockPool&&) = delete;
+
+        [[nodiscard]] void* allocate(size_t block_size, size_t alignment);
+        void deallocate(void* block) noexcept;
+
+        // Ensures at least count blocks can be allocated without growing the pool
+        // If the block size isn't known yet, the reservation is made on the first allocation
+        void reserve(size_t count);
+
+        [[nodiscard]] size_t num_allocated() const noexcept;
+        [[nodiscard]] size_t capacity() const noexcept;
+
+        // Walks the free list to measure fragmentation, so is linear in the number of free blocks
+        [[nodiscard]] PoolStats stats() const;
+
+        [[nodiscard]] static std::vector<PoolStats> all_stats();
+
+    private:
+        struct FreeBlock
+        {
+            FreeBlock* next;
+        };
+
+        struct Chunk
+        {
+            std::byte* memory;
+            size_t num_blocks;
+        };
+
+        // Must be called with the mutex held
+        void grow(size_t count);
+
+        mutable std::mutex _mutex;
+        const char* _name;
+        size_t _block_size;
+        size_t _alignment;
+        size_t _reserve_hint;
+        size_t _num_free;
+        size_t _capacity;
+        size_t _peak_allocated;
+        FreeBlock* _free_list;
+        std::vector<Chunk> _chunks;
+    };
+
+    // Each type gets its own pool, which is intentionally leaked so that it outlives every pooled object
+    template <typename T>
+    [[nodiscard]] BlockPool& block_pool()
+    {
+        static BlockPool& pool = *new BlockPool(typeid(T).name());
+        return pool;
+    }
+}
@@ -0,0 +1,54 @@
+#include "frame_arena.h"
+
+#include <algorithm>
+
+#include <utils/strtools.h>
+#include <profiling/scoped_event.h>
+
+using namespace memory;
+
+FrameArena::ThreadArena::ThreadArena(size_t block_size)
+    : allocator(block_size)
+    , resource(allocator)
+{ }
+
+std::pmr::memory_resource* FrameArena::resource()
+{
+    // Arenas are owned by the frame arena so that memory handed out by a thread outlives the thread itself
+    thread_local ThreadArena* arena = nullptr;
+    if (!arena)
+    {
+        std::lock_guard lock(_thread_arenas_mutex);
+        arena = _thread_arenas.emplace_back(std::make_unique<ThreadArena>(initial_block_size)).get();
+    }
+
+    return &arena->resource;
+}
+
+void FrameArena::reset()
+{
+    std::lock_guard lock(_thread_arenas_mutex);
+
+    const size_t peak_bytes_used = _stats.peak_bytes_used;
+    _stats = FrameArenaStats();
+    _stats.thread_arenas = static_cast<int32_t>(_thread_arenas.size());
+
+    for (const std::unique_ptr<ThreadArena>& arena : _thread_arenas)
+    {
+        _stats.overflow_blocks += static_cast<int32_t>(arena->allocator.num_blocks()) - 1;
+        _stats.bytes_used += arena->allocator.bytes_used();
+        _stats.bytes_reserved += arena->allocator.bytes_reserved();
+    }
+
+    _stats.peak_bytes_used = std::max(peak_bytes_used, _stats.bytes_used);
+
+    SCOPED_EVENT("FrameArena - reset", strtools::catf_temp(
+        "%zu bytes used, %zu peak, %d overflow blocks",
+        _stats.bytes_used, _stats.peak_bytes_used, _stats.overflow_blocks
+    ));
+
+    for (const std::unique_ptr<ThreadArena>& arena : _thread_arenas)
+    {
+        arena->allocator.reset();
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <memory_resource>
+
+#include <utils/singleton.h>
+
+#include "linear_allocator.h"
+#include "frame_arena_stats.h"
+
+namespace memory
+{
+    // Memory for transient data that only lives until the end of the frame
+    // Each thread allocates from its own linear allocator without locking, and all of them are reset together
+    // once the frame is over, so nothing allocated from the arena may outlive the frame it was allocated in
+    //
+    // Containers should be used on the thread they were created on, as they hold that thread's memory resource
+    // reset must be called from the main thread while no other thread is using the arena
+    class FrameArena : public utils::Singleton<FrameArena>
+    {
+        using Singleton::Singleton;
+
+    public:
+        // The memory resource of the calling thread
+        [[nodiscard]] std::pmr::memory_resource* resource();
+
+        void reset();
+
+        [[nodiscard]] const FrameArenaStats& stats() const noexcept { return _stats; }
+
+    private:
+        struct ThreadArena
+        {
+            explicit ThreadArena(size_t block_size);
+
+            LinearAllocator allocator;
+            LinearMemoryResource resource;
+        };
+
+        static constexpr size_t initial_block_size = 64 * 1024;
+
+        std::mutex _thread_arenas_mutex;
+        std::vector<std::unique_ptr<ThreadArena>> _thread_arenas;
+        FrameArenaStats _stats;
+    };
+
+    // Shorthand for the calling thread's frame arena resource, used to construct std::pmr containers
+    [[nodiscard]] inline std::pmr::memory_resource* frame_resource()
+    {
+        return FrameArena::get().resource();
+    }
+}
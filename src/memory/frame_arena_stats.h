@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace memory
+{
+    // Various stats about the memory used by the frame arena in the last frame
+    struct FrameArenaStats
+    {
+        int32_t thread_arenas = 0;
+        int32_t overflow_blocks = 0;
+
+        size_t bytes_used = 0;
+        size_t bytes_reserved = 0;
+
+        // The most bytes used by any single frame so far
+        size_t peak_bytes_used = 0;
+    };
+}
@@ -1,14 +1,159 @@
 #include "gc.h"
 
+#include <iterator>
+#include <algorithm>
+
+#include <utils/check.h>
+#include <utils/timing.h>
+#include <utils/strtools.h>
+
 #include "profiling/scoped_event.h"
 
 using namespace memory;
 
+GC::GC()
+    : _main_thread(std::this_thread::get_id())
+{ }
+
+GC::~GC()
+{
+    shutdown();
+}
+
 void GC::tick()
 {
-    SCOPED_EVENT("GC - tick");
-    update_trackers();
-    free_garbage();
+    check(on_main_thread());
+
+    SCOPED_EVENT("GC - tick", strtools::catf_temp(
+        "%d tracked, %d dead, %d garbage",
+        _stats.tracked_objects, _stats.dead_objects, _stats.pending_garbage
+    ));
+
+    const int32_t dead_objects = _stats.dead_objects;
+    _stats = GCStats();
+    _stats.dead_objects = dead_objects;
+
+    drain_thread_queues();
+
+    _stats.scan_time_ms = timing::measure_ms([this] { update_trackers(); });
+    _stats.free_time_ms = timing::measure_ms([this] { free_garbage(); });
+
+    _stats.tracked_objects = static_cast<int32_t>(_tracked_objects.size());
+    _stats.pending_garbage = static_cast<int32_t>(_garbage.size());
+
+    _frame++;
+}
+
+void GC::set_scan_budget(int32_t max_objects) noexcept
+{
+    check(max_objects >= 0);
+    _scan_budget = max_objects;
+}
+
+void GC::set_free_budget(int32_t max_objects, double max_time_us) noexcept
+{
+    check(max_objects >= 0);
+    check(max_time_us >= 0);
+
+    _free_budget_objects = max_objects;
+    _free_budget_us = max_time_us;
+}
+
+void GC::flush_garbage()
+{
+    SCOPED_EVENT("GC - flush garbage", strtools::catf_temp("%d objects", _garbage.size()));
+    _garbage.clear();
+}
+
+void GC::shutdown()
+{
+    SCOPED_EVENT("GC - shutdown");
+    check(on_main_thread());
+
+    // Releasing objects may queue or release more objects, so keep going until every queue stays empty
+    do
+    {
+        _tracked_objects.clear();
+        _garbage.clear();
+    }
+    while (drain_thread_queues());
+
+    _scan_cursor = 0;
+    _stats = GCStats();
+}
+
+GC::ThreadQueue& GC::thread_queue()
+{
+    // Queues are owned by the GC so that anything queued outlives the thread that queued it
+    thread_local ThreadQueue* queue = nullptr;
+    if (!queue)
+    {
+        std::lock_guard lock(_thread_queues_mutex);
+        queue = _thread_queues.emplace_back(std::make_unique<ThreadQueue>()).get();
+    }
+
+    return *queue;
+}
+
+bool GC::on_main_thread() const noexcept
+{
+    return std::this_thread::get_id() == _main_thread;
+}
+
+void GC::track(Tracker&& tracker)
+{
+    ThreadQueue& queue = thread_queue();
+
+    std::lock_guard lock(queue.mutex);
+    queue.trackers.push_back(std::move(tracker));
+}
+
+void GC::defer_destroy(void* object, void (*destroy)(void* object))
+{
+    ThreadQueue& queue = thread_queue();
+
+    std::lock_guard lock(queue.mutex);
+    queue.destroys.push_back({ object, destroy });
+}
+
+bool GC::drain_thread_queues()
+{
+    SCOPED_EVENT("GC - drain thread queues");
+
+    // Queues are never removed, but are listed under the lock as destructors may queue from a thread for the first time
+    {
+        std::lock_guard lock(_thread_queues_mutex);
+        for (const std::unique_ptr<ThreadQueue>& queue : _thread_queues)
+        {
+            _draining_queues.push_back(queue.get());
+        }
+    }
+
+    bool drained = false;
+    for (ThreadQueue* queue : _draining_queues)
+    {
+        // Each queue is taken under its lock but processed outside of it, as destructors may allocate or release objects
+        {
+            std::lock_guard lock(queue->mutex);
+            std::swap(_drained_trackers, queue->trackers);
+            std::swap(_drained_destroys, queue->destroys);
+        }
+
+        drained |= !_drained_trackers.empty() || !_drained_destroys.empty();
+
+        std::ranges::move(_drained_trackers, std::back_inserter(_tracked_objects));
+        _drained_trackers.clear();
+
+        for (const PendingDestroy& destroy : _drained_destroys)
+        {
+            destroy.destroy(destroy.object);
+        }
+
+        _drained_destroys.clear();
+    }
+
+    _draining_queues.clear();
+    return drained;
 }
 
 bool GC::Tracker::dead() const noexcept
@@ -18,30 +163,96 @@ bool GC::Tracker::dead() const noexcept
 
 void GC::update_trackers()
 {
-    SCOPED_EVENT("GC - update trackers");
+    const size_t num_scans =
+        _scan_budget > 0
+        ? std::min(_tracked_objects.size(), static_cast<size_t>(_scan_budget))
+        : _tracked_objects.size();
+
+    SCOPED_EVENT("GC - update trackers", strtools::catf_temp("%d of %d objects", num_scans, _tracked_objects.size()));
 
-    for (int32_t i = static_cast<int32_t>(_tracked_objects.size()) - 1; i >= 0; i--)
+    // The cursor picks up where the last frame's scan left off, wrapping around once it reaches the end
+    for (size_t scanned = 0; scanned < num_scans && !_tracked_objects.empty(); scanned++)
     {
-        Tracker& tracker = _tracked_objects[i];
+        if (_scan_cursor >= _tracked_objects.size())
+        {
+            _scan_cursor = 0;
+        }
+
+        Tracker& tracker = _tracked_objects[_scan_cursor];
+        const bool was_dead = tracker.dead_since >= 0;
 
-        // Reset the dead frames counter if object is alive, otherwise increment it
-        tracker.dead_frames =
-            tracker.dead()
-            ? tracker.dead_frames + 1
-            : 0;
+        if (!tracker.dead())
+        {
+            tracker.dead_since = -1;
+            _stats.dead_objects -= was_dead;
+            _scan_cursor++;
+            continue;
+        }
 
-        // If an tracker has been dead sufficiently long according to it's policy, enqueue for destruction
-        if (tracker.dead_frames >= 2)
+        if (!was_dead)
+        {
+            tracker.dead_since = _frame;
+            _stats.dead_objects++;
+        }
+
+        // Dead frames are counted inclusively, so an object seen dead on consecutive frames has been dead for two
+        if (_frame - tracker.dead_since + 1 >= tracker.policy->dead_frames)
         {
             _garbage.push_back(std::move(tracker));
-            _tracked_objects.erase(_tracked_objects.begin() + i);
+            _stats.dead_objects--;
+
+            // The last object takes the collected object's place and has yet to be scanned this pass
+            if (&tracker != &_tracked_objects.back())
+            {
+                tracker = std::move(_tracked_objects.back());
+            }
+
+            _tracked_objects.pop_back();
+        }
+        else
+        {
+            _scan_cursor++;
         }
+
+        _stats.scanned_objects++;
     }
 }
 
 void GC::free_garbage()
 {
-    // Currently just free all garbage at once
-    SCOPED_EVENT("GC - free garbage");
-    _garbage.clear();
+    if (_garbage.empty())
+    {
+        return;
+    }
+
+    SCOPED_EVENT("GC - free garbage", strtools::catf_temp("%d objects", _garbage.size()));
+
+    const timing::clock::time_point start = timing::clock::now();
+    const timing::duration_ms max_time = timing::duration_ms(_free_budget_us / 1000);
+
+    while (!_garbage.empty())
+    {
+        // Objects revived through a weak_ptr while waiting to be freed go back to being tracked
+        if (!_garbage.front().dead())
+        {
+            _garbage.front().dead_since = -1;
+            _tracked_objects.push_back(std::move(_garbage.front()));
+            _garbage.pop_front();
+            _stats.revived_objects++;
+            continue;
+        }
+
+        _garbage.pop_front();
+        _stats.freed_objects++;
+
+        if (_free_budget_objects > 0 && _stats.freed_objects >= _free_budget_objects)
+        {
+            break;
+        }
+
+        if (_free_budget_us > 0 && timing::clock::now() - start >= max_time)
+        {
+            break;
+        }
+    }
 }
@@ -1,51 +1,192 @@
 #pragma once
 
+#include <deque>
+#include <mutex>
+#include <memory>
+#include <thread>
+#include <vector>
+
 #include <utils/singleton.h>
 
 #include "shared_ptr.h"
+#include "pool_allocator.h"
+#include "gc_stats.h"
 
 namespace memory
 {
-    // TODO: add more control over GC policies
+    // Types that own resources tied to the main thread, such as objects in the GL context,
+    // declare static constexpr bool destroy_on_main_thread = true
+    template <typename T>
+    concept main_thread_destroyed = requires
+    {
+        requires T::destroy_on_main_thread;
+    };
+
+    // Controls when tracked objects of a type are collected
+    struct GCPolicy
+    {
+        // Number of frames an object must stay dead, with no strong references outside the GC, before it is freed
+        int32_t dead_frames = 2;
+    };
+
+    // Tracks objects allocated through alloc, freeing them once they have been dead for long enough
+    // Tracked objects are scanned incrementally over several frames, and garbage is freed within a per frame budget
+    // so that releasing a large number of objects at once is spread out rather than causing a spike
+    //
+    // alloc may be called from any thread, with each thread queueing its objects in its own queue until the next tick,
+    // so queueing only contends with the main thread taking the queue
+    // The main thread is the thread that constructs the GC, and is the only thread that may tick it and free garbage
+    // Objects that are main_thread_destroyed and released on another thread, such as after being revived through
+    // a weak_ptr, have their destruction deferred to the next tick
     class GC : public utils::Singleton<GC>
     {
-        using Singleton::Singleton;
+        friend Singleton;
 
     public:
+        GC();
+        ~GC();
+
         template <typename T, typename...Args>
         requires std::constructible_from<T, Args...>
         [[nodiscard]] static peng::shared_ref<T> alloc(Args&&...args);
 
+        // Policies apply to objects of exactly type T, including ones that are already tracked
+        template <typename T>
+        static void set_policy(const GCPolicy& policy);
+
         void tick();
 
+        // Limits the number of tracked objects scanned each frame, or 0 to scan every object every frame
+        void set_scan_budget(int32_t max_objects) noexcept;
+
+        // Limits the garbage freed each frame by count and time, where 0 disables either limit
+        // At least one object is always freed when there is garbage, so that the GC can't stall
+        void set_free_budget(int32_t max_objects, double max_time_us) noexcept;
+
+        // Frees all garbage immediately, ignoring the free budget
+        void flush_garbage();
+
+        // Takes everything queued by every thread and releases every tracked object, so that nothing is left to the
+        // GC's static destruction. Objects still referenced elsewhere are destroyed when their last reference is released
+        void shutdown();
+
+        [[nodiscard]] const GCStats& stats() const noexcept { return _stats; }
+
     private:
         struct Tracker
         {
             peng::shared_ref<void> object;
-            int32_t dead_frames = 0;
+            const GCPolicy* policy;
+
+            // The frame the object was first seen dead in, or -1 if it was alive when last scanned
+            int64_t dead_since = -1;
 
             // We consider a tracked object dead if there are no longer any strong
             // references left to it. Dead objects can still be revived via weak_ptrs however
             [[nodiscard]] bool dead() const noexcept;
         };
 
+        struct PendingDestroy
+        {
+            void* object;
+            void (*destroy)(void* object);
+        };
+
+        // Objects allocated or released by a thread, pushed by that thread and taken all at once by the main thread
+        // Taking a queue swaps its vectors for the main thread's empty ones, so pushing reuses their capacity and
+        // doesn't allocate once the queue has grown to fit a frame's worth of objects
+        struct ThreadQueue
+        {
+            std::mutex mutex;
+            std::vector<Tracker> trackers;
+            std::vector<PendingDestroy> destroys;
+        };
+
+        template <typename T>
+        [[nodiscard]] static GCPolicy& policy();
+
+        template <typename T, typename...Args>
+        [[nodiscard]] static peng::shared_ref<T> make_tracked(Args&&...args);
+
+        [[nodiscard]] ThreadQueue& thread_queue();
+        [[nodiscard]] bool on_main_thread() const noexcept;
+
+        void track(Tracker&& tracker);
+        void defer_destroy(void* object, void (*destroy)(void* object));
+        // Returns whether anything was queued
+        bool drain_thread_queues();
+
         void update_trackers();
         void free_garbage();
-        
+
         std::vector<Tracker> _tracked_objects;
-        std::vector<Tracker> _garbage;
+        std::deque<Tracker> _garbage;
+
+        size_t _scan_cursor = 0;
+        int64_t _frame = 0;
+
+        int32_t _scan_budget = 4096;
+        int32_t _free_budget_objects = 0;
+        double _free_budget_us = 500;
+
+        GCStats _stats;
+
+        const std::thread::id _main_thread;
+        std::mutex _thread_queues_mutex;
+        std::vector<std::unique_ptr<ThreadQueue>> _thread_queues;
+
+        // Only used by the main thread while draining the queues
+        std::vector<ThreadQueue*> _draining_queues;
+        std::vector<Tracker> _drained_trackers;
+        std::vector<PendingDestroy> _drained_destroys;
     };
 
     template <typename T, typename ... Args> requires std::constructible_from<T, Args...>
     peng::shared_ref<T> GC::alloc(Args&&... args)
     {
-        // TODO: make it thread safe to alloc
-        peng::shared_ref<T> obj = peng::make_shared<T>(std::forward<Args>(args)...);
-        get()._tracked_objects.push_back(Tracker{
+        peng::shared_ref<T> obj = make_tracked<T>(std::forward<Args>(args)...);
+        get().track(Tracker{
             .object = obj,
-            .dead_frames = 0
+            .policy = &policy<T>()
         });
 
         return obj;
     }
+
+    template <typename T, typename...Args>
+    peng::shared_ref<T> GC::make_tracked(Args&&...args)
+    {
+        // Objects with a custom deleter can't share a pooled block with their control block, so aren't pooled
+        if constexpr (main_thread_destroyed<T>)
+        {
+            return peng::shared_ref<T>(std::shared_ptr<T>(new T(std::forward<Args>(args)...), [](T* object)
+            {
+                if (get().on_main_thread())
+                {
+                    delete object;
+                }
+                else
+                {
+                    get().defer_destroy(object, [](void* deferred) { delete static_cast<T*>(deferred); });
+                }
+            }));
+        }
+        else
+        {
+            return make_pooled<T>(std::forward<Args>(args)...);
+        }
+    }
+
+    template <typename T>
+    void GC::set_policy(const GCPolicy& policy)
+    {
+        GC::policy<T>() = policy;
+    }
+
+    template <typename T>
+    GCPolicy& GC::policy()
+    {
+        static GCPolicy policy;
+        return policy;
+    }
 }
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+
+namespace memory
+{
+    // Various stats about the work done by the GC in the last frame
+    struct GCStats
+    {
+        int32_t tracked_objects = 0;
+        int32_t dead_objects = 0;
+        int32_t pending_garbage = 0;
+
+        int32_t scanned_objects = 0;
+        int32_t freed_objects = 0;
+        int32_t revived_objects = 0;
+
+        double scan_time_ms = 0;
+        double free_time_ms = 0;
+    };
+}
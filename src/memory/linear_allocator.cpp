@@ -0,0 +1,100 @@
+#include "linear_allocator.h"
+
+#include <bit>
+#include <cstdint>
+#include <algorithm>
+
+#include <utils/check.h>
+
+using namespace memory;
+
+LinearAllocator::LinearAllocator(size_t block_size)
+    : _cursor(nullptr)
+    , _end(nullptr)
+    , _bytes_used(0)
+    , _bytes_reserved(0)
+{
+    check(block_size > 0);
+    add_block(block_size);
+}
+
+void* LinearAllocator::allocate(size_t size, size_t alignment)
+{
+    check(std::has_single_bit(alignment));
+
+    size = std::max<size_t>(size, 1);
+
+    std::byte* ptr = reinterpret_cast<std::byte*>(
+        (reinterpret_cast<uintptr_t>(_cursor) + alignment - 1) & ~(uintptr_t(alignment) - 1)
+    );
+
+    if (ptr + size > _end)
+    {
+        // Overflow blocks at least double in size so that a frame only ever needs a few of them
+        add_block(std::max(_blocks.back().size * 2, size + alignment));
+        return allocate(size, alignment);
+    }
+
+    _bytes_used += (ptr + size) - _cursor;
+    _cursor = ptr + size;
+
+    return ptr;
+}
+
+void LinearAllocator::deallocate(void* ptr, size_t size) noexcept
+{
+    std::byte* const bytes = static_cast<std::byte*>(ptr);
+    if (bytes && bytes + std::max<size_t>(size, 1) == _cursor)
+    {
+        _bytes_used -= _cursor - bytes;
+        _cursor = bytes;
+    }
+}
+
+void LinearAllocator::reset()
+{
+    if (_blocks.size() > 1)
+    {
+        // Everything from the last frame fits in one block, so the next frame shouldn't need to overflow
+        const size_t total_size = _bytes_reserved;
+        _blocks.clear();
+        _bytes_reserved = 0;
+
+        add_block(total_size);
+    }
+
+    _cursor = _blocks.back().memory.get();
+    _end = _cursor + _blocks.back().size;
+    _bytes_used = 0;
+}
+
+void LinearAllocator::add_block(size_t min_size)
+{
+    Block& block = _blocks.emplace_back(Block{
+        .memory = std::make_unique_for_overwrite<std::byte[]>(min_size),
+        .size = min_size
+    });
+
+    _cursor = block.memory.get();
+    _end = _cursor + block.size;
+    _bytes_reserved += block.size;
+}
+
+LinearMemoryResource::LinearMemoryResource(LinearAllocator& allocator) noexcept
+    : _allocator(allocator)
+{ }
+
+void* LinearMemoryResource::do_allocate(size_t bytes, size_t alignment)
+{
+    return _allocator.allocate(bytes, alignment);
+}
+
+void LinearMemoryResource::do_deallocate(void* ptr, size_t bytes, size_t)
+{
+    _allocator.deallocate(ptr, bytes);
+}
+
+bool LinearMemoryResource::do_is_equal(const memory_resource& other) const noexcept
+{
+    return this == &other;
+}
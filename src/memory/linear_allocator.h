@@ -0,0 +1,61 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <memory_resource>
+
+namespace memory
+{
+    // Allocates by bumping a pointer through blocks of memory, which are only ever freed all at once by reset
+    // Running out of space in the current block chains on a new block instead of moving existing allocations
+    // Not thread safe, each thread should have its own allocator
+    class LinearAllocator
+    {
+    public:
+        explicit LinearAllocator(size_t block_size);
+        LinearAllocator(const LinearAllocator&) = delete;
+        LinearAllocator(LinearAllocator&&) = delete;
+
+        [[nodiscard]] void* allocate(size_t size, size_t alignment);
+
+        // Only the most recent allocation can be given back, which lets containers that grow in place reuse it
+        void deallocate(void* ptr, size_t size) noexcept;
+
+        // Frees every allocation, merging any overflow blocks into a single block large enough for all of them
+        void reset();
+
+        [[nodiscard]] size_t bytes_used() const noexcept { return _bytes_used; }
+        [[nodiscard]] size_t bytes_reserved() const noexcept { return _bytes_reserved; }
+        [[nodiscard]] size_t num_blocks() const noexcept { return _blocks.size(); }
+
+    private:
+        struct Block
+        {
+            std::unique_ptr<std::byte[]> memory;
+            size_t size;
+        };
+
+        void add_block(size_t min_size);
+
+        std::vector<Block> _blocks;
+        std::byte* _cursor;
+        std::byte* _end;
+        size_t _bytes_used;
+        size_t _bytes_reserved;
+    };
+
+    // Adapts a linear allocator for use with std::pmr containers
+    class LinearMemoryResource : public std::pmr::memory_resource
+    {
+    public:
+        explicit LinearMemoryResource(LinearAllocator& allocator) noexcept;
+
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+        [[nodiscard]] bool do_is_equal(const memory_resource& other) const noexcept override;
+
+        LinearAllocator& _allocator;
+    };
+}
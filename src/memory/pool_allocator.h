@@ -0,0 +1,66 @@
+#pragma once
+
+#include <memory>
+
+#include "block_pool.h"
+#include "shared_ref.h"
+
+namespace memory
+{
+    // Allocates single objects from the block pool of Pooled, and arrays from the default allocator
+    // Rebinding keeps the pool, so std::allocate_shared places the control block and object in one pooled block
+    template <typename T, typename Pooled = T>
+    class PoolAllocator
+    {
+    public:
+        using value_type = T;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = PoolAllocator<U, Pooled>;
+        };
+
+        PoolAllocator() noexcept = default;
+
+        template <typename U>
+        PoolAllocator(const PoolAllocator<U, Pooled>&) noexcept
+        { }
+
+        [[nodiscard]] T* allocate(size_t n)
+        {
+            if (n != 1)
+            {
+                return std::allocator<T>().allocate(n);
+            }
+
+            return static_cast<T*>(block_pool<Pooled>().allocate(sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T* ptr, size_t n) noexcept
+        {
+            if (n != 1)
+            {
+                std::allocator<T>().deallocate(ptr, n);
+            }
+            else
+            {
+                block_pool<Pooled>().deallocate(ptr);
+            }
+        }
+
+        template <typename U>
+        [[nodiscard]] bool operator==(const PoolAllocator<U, Pooled>&) const noexcept
+        {
+            return true;
+        }
+    };
+
+    // Constructs a shared object whose storage comes from the block pool of T
+    template <typename T, typename...Args>
+    requires std::constructible_from<T, Args...>
+    [[nodiscard]] peng::shared_ref<T> make_pooled(Args&&...args)
+    {
+        return peng::shared_ref<T>(std::allocate_shared<T>(PoolAllocator<T>(), std::forward<Args>(args)...));
+    }
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+
+namespace memory
+{
+    // Various stats about the occupancy of a block pool
+    struct PoolStats
+    {
+        const char* name = nullptr;
+
+        size_t block_size = 0;
+        size_t num_chunks = 0;
+        size_t capacity = 0;
+        size_t allocated_blocks = 0;
+        size_t peak_allocated_blocks = 0;
+
+        // Fraction of the capacity that is allocated
+        double occupancy = 0;
+
+        // Fraction of the free blocks that are scattered through chunks which are still partly allocated
+        // Free blocks in fully free chunks are contiguous, so don't count towards it
+        double fragmentation = 0;
+    };
+}
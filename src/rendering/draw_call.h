@@ -1,12 +1,20 @@
 #pragma once
 
+#include <tuple>
+#include <vector>
+
 #include <memory/shared_ptr.h>
 
+#include "shader.h"
+
 namespace rendering
 {
     class Mesh;
     class Material;
 
+    // Uniforms and the values they are set to for a single draw
+    using DrawUniforms = std::vector<std::tuple<GLint, Shader::Parameter>>;
+
     // Draw calls specify an object to draw and its corresponding material
     // They should be used instead of drawing objects directly to allow the
     // draw call tree to automatically sort draw calls minimize state switches
@@ -17,5 +25,10 @@ namespace rendering
         peng::shared_ptr<Material> material;
         float order = 0;
         int32_t instance_count = 1;
+
+        // Uniforms that vary per draw, such as transforms and the camera, snapshotted when the draw is enqueued
+        // They are applied on top of the material's own uniforms, so a draw is unaffected by later changes to the
+        // material's state, such as by the next frame ticking while this one is submitted
+        DrawUniforms uniforms;
     };
 }
@@ -2,6 +2,7 @@
 
 #include <profiling/scoped_event.h>
 #include <profiling/scoped_gpu_event.h>
+#include <memory/frame_arena.h>
 #include <utils/strtools.h>
 #include <utils/vectools.h>
 
@@ -14,17 +15,20 @@
 using namespace rendering;
 
 DrawCallTree::DrawCallTree(std::vector<DrawCall>&& draw_calls)
+    : _resource(memory::frame_resource())
+    , _shader_draws(_resource)
+    , _shader_draw_indices(_resource)
+    , _mesh_draw_indices(_resource)
 {
     SCOPED_EVENT("Building DrawCallTree", strtools::catf_temp("%d draw calls", draw_calls.size()));
 
-    std::vector<DrawCall> draw_calls_ordered(std::move(draw_calls));
-    std::ranges::sort(draw_calls_ordered,
+    std::ranges::sort(draw_calls,
         [](const DrawCall& x, const DrawCall& y)
         {
             return x.order < y.order;
         });
 
-    for (DrawCall& draw_call : draw_calls_ordered)
+    for (DrawCall& draw_call : draw_calls)
     {
         check(draw_call.material);
         check(draw_call.mesh);
@@ -78,6 +82,7 @@ void DrawCallTree::execute(RenderQueueStats& stats) const
                 check(draw_call.material->shader() == shader_draw.shader);
 
                 draw_call.material->apply_uniforms();
+                draw_call.material->apply_draw_uniforms(draw_call.uniforms);
                 draw_call.material->bind_buffers();
 
                 if (draw_call.instance_count == 1)
@@ -110,7 +115,8 @@ void DrawCallTree::add_blended_draw(DrawCall&& draw_call)
     if (!shader_draw || shader_draw->shader != draw_call.material->shader())
     {
         shader_draw = &_shader_draws.emplace_back(ShaderDrawTree{
-            .shader = draw_call.material->shader()
+            .shader = draw_call.material->shader(),
+            .mesh_draws = std::pmr::vector<MeshDrawTree>(_resource)
         });
     }
 
@@ -118,7 +124,8 @@ void DrawCallTree::add_blended_draw(DrawCall&& draw_call)
     if (!mesh_draw || mesh_draw->mesh != draw_call.mesh)
     {
         mesh_draw = &shader_draw->mesh_draws.emplace_back(MeshDrawTree{
-            .mesh = draw_call.mesh.to_shared_ref()
+            .mesh = draw_call.mesh.to_shared_ref(),
+            .draw_calls = std::pmr::vector<DrawCall>(_resource)
         });
     }
 
@@ -136,9 +143,9 @@ void DrawCallTree::merge_tree()
     }
 }
 
-std::vector<ShaderDrawTree> DrawCallTree::merge_shader_draws(std::vector<ShaderDrawTree>&& shader_draws) const
+std::pmr::vector<ShaderDrawTree> DrawCallTree::merge_shader_draws(std::pmr::vector<ShaderDrawTree>&& shader_draws) const
 {
-    std::vector<ShaderDrawTree> merged_draws;
+    std::pmr::vector<ShaderDrawTree> merged_draws(_resource);
 
     for (ShaderDrawTree& shader_draw : shader_draws)
     {
@@ -156,9 +163,9 @@ std::vector<ShaderDrawTree> DrawCallTree::merge_shader_draws(std::vector<ShaderD
     return merged_draws;
 }
 
-std::vector<MeshDrawTree> DrawCallTree::merge_mesh_draws(std::vector<MeshDrawTree>&& mesh_draws) const
+std::pmr::vector<MeshDrawTree> DrawCallTree::merge_mesh_draws(std::pmr::vector<MeshDrawTree>&& mesh_draws) const
 {
-    std::vector<MeshDrawTree> merged_draws;
+    std::pmr::vector<MeshDrawTree> merged_draws(_resource);
 
     for (MeshDrawTree& mesh_draw : mesh_draws)
     {
@@ -183,15 +190,14 @@ ShaderDrawTree& DrawCallTree::find_add_shader_draw(const peng::shared_ref<const
         return _shader_draws[it->second];
     }
 
-    const ShaderDrawTree shader_draw = {
-        .index = _shader_draws.size(),
-        .shader = shader
-    };
+    const size_t index = _shader_draws.size();
+    _shader_draw_indices[shader] = index;
 
-    _shader_draw_indices[shader] = shader_draw.index;
-    _shader_draws.push_back(shader_draw);
-
-    return _shader_draws[shader_draw.index];
+    return _shader_draws.emplace_back(ShaderDrawTree{
+        .index = index,
+        .shader = shader,
+        .mesh_draws = std::pmr::vector<MeshDrawTree>(_resource)
+    });
 }
 
 MeshDrawTree& DrawCallTree::find_add_mesh_draw(const peng::shared_ref<const Shader>& shader,
@@ -205,15 +211,14 @@ MeshDrawTree& DrawCallTree::find_add_mesh_draw(const peng::shared_ref<const Shad
     }
 
     ShaderDrawTree& shader_draw = find_add_shader_draw(shader);
-    std::vector<MeshDrawTree>& mesh_draws = shader_draw.mesh_draws;
-
-    const MeshDrawTree mesh_draw = {
-        .index = mesh_draws.size(),
-        .mesh = mesh
-    };
+    std::pmr::vector<MeshDrawTree>& mesh_draws = shader_draw.mesh_draws;
 
-    _mesh_draw_indices[key] = std::make_tuple(shader_draw.index, mesh_draw.index);
-    mesh_draws.push_back(mesh_draw);
+    const size_t index = mesh_draws.size();
+    _mesh_draw_indices[key] = std::make_tuple(shader_draw.index, index);
 
-    return mesh_draws[mesh_draw.index];
+    return mesh_draws.emplace_back(MeshDrawTree{
+        .index = index,
+        .mesh = mesh,
+        .draw_calls = std::pmr::vector<DrawCall>(_resource)
+    });
 }
@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <unordered_map>
+#include <memory_resource>
 
 #include <memory/shared_ref.h>
 #include <utils/hash_helpers.h>
@@ -21,7 +22,7 @@ namespace rendering
     {
         size_t index;
         peng::shared_ref<const Mesh> mesh;
-        std::vector<DrawCall> draw_calls;
+        std::pmr::vector<DrawCall> draw_calls;
     };
 
     // Draw calls aggregated by the shader. Each draw may differ by mesh and uniforms
@@ -29,14 +30,16 @@ namespace rendering
     {
         size_t index;
         peng::shared_ref<const Shader> shader;
-        std::vector<MeshDrawTree> mesh_draws;
+        std::pmr::vector<MeshDrawTree> mesh_draws;
     };
 
     // Tree of draw calls aggregated by shader, then mesh, the uniforms
     // This allows all draw calls to be executed with minimal state switches
+    // The tree is rebuilt every frame so all of its storage comes from the frame arena, and it must not outlive the frame
     class DrawCallTree
     {
     public:
+        // The draw calls are moved out of, but the vector itself is left for the caller to clear and reuse
         explicit DrawCallTree(std::vector<DrawCall>&& draw_calls);
 
         void execute(RenderQueueStats& stats) const;
@@ -52,10 +55,10 @@ namespace rendering
         void merge_tree();
 
         // Merges adjacent shader draws in the tree
-        std::vector<ShaderDrawTree> merge_shader_draws(std::vector<ShaderDrawTree>&& shader_draws) const;
+        std::pmr::vector<ShaderDrawTree> merge_shader_draws(std::pmr::vector<ShaderDrawTree>&& shader_draws) const;
 
         // Merges adjacent mesh draws in the tree
-        std::vector<MeshDrawTree> merge_mesh_draws(std::vector<MeshDrawTree>&& mesh_draws) const;
+        std::pmr::vector<MeshDrawTree> merge_mesh_draws(std::pmr::vector<MeshDrawTree>&& mesh_draws) const;
 
         ShaderDrawTree& find_add_shader_draw(const peng::shared_ref<const Shader>& shader);
 
@@ -64,11 +67,12 @@ namespace rendering
             const peng::shared_ref<const Mesh>& mesh
         );
 
-        std::vector<ShaderDrawTree> _shader_draws;
-        std::unordered_map<peng::shared_ref<const Shader>, size_t> _shader_draw_indices;
+        std::pmr::memory_resource* _resource;
+        std::pmr::vector<ShaderDrawTree> _shader_draws;
+        std::pmr::unordered_map<peng::shared_ref<const Shader>, size_t> _shader_draw_indices;
 
         // Maps from a (shader, mesh) key to a (shader_draw index, mesh_draw sub index) value
-        std::unordered_map<
+        std::pmr::unordered_map<
             std::tuple<
             peng::shared_ref<const Shader>,
             peng::shared_ref<const Mesh>
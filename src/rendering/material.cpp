@@ -115,6 +115,16 @@ void Material::apply_uniforms()
     }
 }
 
+void Material::apply_draw_uniforms(const std::vector<std::tuple<GLint, Shader::Parameter>>& uniforms)
+{
+    for (const auto& [location, parameter] : uniforms)
+    {
+        std::visit(functional::overload{
+            [&](const auto& x) { apply_parameter(location, x); }
+        }, parameter);
+    }
+}
+
 void Material::bind_buffers()
 {
     for (const auto& [index, buffer] : _bound_buffers)
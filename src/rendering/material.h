@@ -25,6 +25,9 @@ namespace rendering
         void apply_uniforms();
         void bind_buffers();
 
+        // Applies uniforms for a single draw on top of the material's own, so must be called after apply_uniforms
+        void apply_draw_uniforms(const std::vector<std::tuple<GLint, Shader::Parameter>>& uniforms);
+
         template <utils::variant_member<Shader::Parameter> T>
         void try_set_parameter(GLint uniform_location, const T& parameter)
         {
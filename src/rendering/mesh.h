@@ -15,6 +15,9 @@ namespace rendering
     class Mesh
     {
     public:
+        // Meshes own GL buffers so must be destroyed with the GL context current, see memory::GC
+        static constexpr bool destroy_on_main_thread = true;
+
         Mesh(std::string&& name, RawMeshData&& raw_data);
         Mesh(const std::string& name, const RawMeshData& raw_data);
         Mesh(const std::string& name, const std::string& mesh_path);
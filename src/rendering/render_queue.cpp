@@ -10,7 +10,12 @@
 using namespace rendering;
 
 RenderQueue::RenderQueue()
-    : _command_queue_consumer(_command_queue)
+    : _command_queue_consumers{
+        moodycamel::ConsumerToken(_command_queues[0]),
+        moodycamel::ConsumerToken(_command_queues[1])
+    }
+    , _enqueue_index(0)
+    , _prepare_index(1)
     , _command_buffer_size(16)
     , _last_command_buffer_usage(0)
 { }
@@ -18,16 +23,43 @@ RenderQueue::RenderQueue()
 void RenderQueue::execute()
 {
     SCOPED_EVENT("RenderQueue - execute");
-    RenderQueueStats stats;
+
+    swap_command_buffers();
+    prepare_frame();
+    submit_frame();
+}
+
+void RenderQueue::swap_command_buffers()
+{
+    _prepare_index = _enqueue_index.fetch_xor(1, std::memory_order_relaxed);
+}
+
+void RenderQueue::prepare_frame()
+{
+    SCOPED_EVENT("RenderQueue - prepare frame");
 
     flush_queue();
+    _sprite_batcher.prepare_draws(_sprite_draw_calls);
+}
 
-    _sprite_batcher.convert_draws(_sprite_draw_calls, _draw_calls);
+void RenderQueue::submit_frame()
+{
+    SCOPED_EVENT("RenderQueue - submit frame");
+    RenderQueueStats stats;
+
+    // Releasing the last reference to a resource frees it through GL, so the commands are only cleared here
+    _sprite_batcher.emit_prepared_draws(_draw_calls);
     _sprite_draw_calls.clear();
 
     const DrawCallTree tree(std::move(_draw_calls));
+    _draw_calls.clear();
+
     tree.execute(stats);
 
+    const threading::JobGraph& sprite_graph = _sprite_batcher.prepare_graph();
+    stats.sprite_prepare_ms = static_cast<float>(sprite_graph.run_time_ms());
+    stats.sprite_critical_path_ms = static_cast<float>(sprite_graph.critical_path_ms());
+
     // TODO: for some reason the texture binding cache breaks after pause if you don't clear it
     TextureBindingCache::get().unbind_all();
     _queue_stats = stats;
@@ -35,7 +67,7 @@ void RenderQueue::execute()
 
 void RenderQueue::enqueue_command(RenderCommand&& command)
 {
-    _command_queue.enqueue(command);
+    _command_queues[_enqueue_index.load(std::memory_order_relaxed)].enqueue(command);
 }
 
 const RenderQueueStats& RenderQueue::last_frame_stats() const noexcept
@@ -51,8 +83,8 @@ void RenderQueue::flush_queue()
     _command_buffer.resize(_command_buffer_size, RenderCommandNullOp());
 
     // Keep dequeuing in bulk until the queue is empty
-    while (const size_t command_count = _command_queue.try_dequeue_bulk(
-        _command_queue_consumer,
+    while (const size_t command_count = _command_queues[_prepare_index].try_dequeue_bulk(
+        _command_queue_consumers[_prepare_index],
         _command_buffer.begin(),
         _command_buffer_size
     ))
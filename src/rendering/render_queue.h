@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <vector>
 
 #include <common/common.h>
@@ -11,6 +13,9 @@
 
 namespace rendering
 {
+    // Commands are double buffered, so that the commands of one frame can be prepared while the next frame enqueues its own
+    // Rendering a frame is split into preparing it, which only touches CPU side data so may happen on any thread,
+    // and submitting it, which uses GL so must happen on the main thread
     class RenderQueue : public utils::Singleton<RenderQueue>
     {
         using Singleton::Singleton;
@@ -18,9 +23,19 @@ namespace rendering
     public:
         RenderQueue();
 
-        // Executes all items in the render queue
+        // Executes all items in the render queue, swapping, preparing and submitting them at once
         void execute();
 
+        // Hands the commands enqueued so far over to be prepared, with new commands going to the other buffer
+        // Must be called from the main thread while nothing is enqueueing commands
+        void swap_command_buffers();
+
+        // Consumes the commands handed over by the last swap and does the CPU side work of drawing them
+        void prepare_frame();
+
+        // Draws the last prepared frame, and releases everything it held
+        void submit_frame();
+
         // Enqueues a render command to the queue
         void enqueue_command(RenderCommand&& command);
 
@@ -33,8 +48,11 @@ namespace rendering
 
         SpriteBatcher _sprite_batcher;
 
-        common::concurrent_queue<RenderCommand> _command_queue;
-        moodycamel::ConsumerToken _command_queue_consumer;
+        std::array<common::concurrent_queue<RenderCommand>, 2> _command_queues;
+        std::array<moodycamel::ConsumerToken, 2> _command_queue_consumers;
+        std::atomic<size_t> _enqueue_index;
+        size_t _prepare_index;
+
         std::vector<RenderCommand> _command_buffer;
         size_t _command_buffer_size;
         size_t _last_command_buffer_usage;
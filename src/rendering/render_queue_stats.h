@@ -11,5 +11,10 @@ namespace rendering
         int32_t triangles = 0;
         int32_t shader_switches = 0;
         int32_t mesh_switches = 0;
+
+        // Time taken to prepare the sprite draws, and how much of it was spent executing the critical path of the
+        // preparation graph, with the rest spent waiting on threads
+        float sprite_prepare_ms = 0;
+        float sprite_critical_path_ms = 0;
     };
 }
@@ -24,6 +24,9 @@ namespace rendering
     class Shader
     {
     public:
+        // Shaders are GL objects so must be destroyed with the GL context current, see memory::GC
+        static constexpr bool destroy_on_main_thread = true;
+
         using Parameter = std::variant<
             int32_t,
             uint32_t,
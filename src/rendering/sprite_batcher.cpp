@@ -1,9 +1,13 @@
 #include "sprite_batcher.h"
 
 #include <ranges>
-#include <execution>
+#include <iterator>
+#include <algorithm>
 
 #include <profiling/scoped_event.h>
+#include <memory/frame_arena.h>
+#include <memory/pool_allocator.h>
+#include <threading/parallel.h>
 #include <utils/strtools.h>
 
 #include "sprite.h"
@@ -16,13 +20,61 @@
 using namespace rendering;
 using namespace math;
 
-void SpriteBatcher::convert_draws(
-    const std::vector<SpriteDrawCall>& sprite_draws_in,
-    std::vector<DrawCall>& draws_out
-)
+SpriteBatcher::SpriteBatcher()
+    : _sprite_draws_in(nullptr)
+    , _prepare_graph("SpriteBatcher")
+{
+    const size_t num_slices = std::min(threading::JobSystem::get().concurrency(), max_preprocess_slices);
+    _preprocessed_slices.resize(num_slices);
+
+    // Each layer is gathered once every slice has been preprocessed, so the gather nodes depend on all of them
+    std::vector<threading::JobGraph::NodeId> preprocess_nodes;
+    for (size_t slice = 0; slice < num_slices; slice++)
+    {
+        preprocess_nodes.push_back(_prepare_graph.add_node(strtools::catf("preprocess %zu", slice), [this, slice, num_slices]
+        {
+            const size_t count = _sprite_draws_in->size();
+            const size_t begin = count * slice / num_slices;
+            const size_t end = count * (slice + 1) / num_slices;
+
+            preprocess_draws(std::span(*_sprite_draws_in).subspan(begin, end - begin), _preprocessed_slices[slice]);
+        }));
+    }
+
+    const threading::JobGraph::NodeId sort_opaque = _prepare_graph.add_node("sort opaque", [this]
+    {
+        gather_draws(&PreprocessedSlice::opaque_draws, _opaque_layer.processed_draws);
+        sort_draws(_opaque_layer.processed_draws);
+    }, preprocess_nodes);
+
+    const threading::JobGraph::NodeId sort_alpha = _prepare_graph.add_node("sort alpha", [this]
+    {
+        gather_draws(&PreprocessedSlice::alpha_draws, _alpha_layer.processed_draws);
+        sort_draws(_alpha_layer.processed_draws);
+    }, preprocess_nodes);
+
+    _prepare_graph.add_node("bin opaque", [this]
+    {
+        bin_opaque_draws(_opaque_layer.processed_draws, _opaque_layer.draw_bins);
+    }, { sort_opaque });
+
+    _prepare_graph.add_node("bin alpha", [this]
+    {
+        bin_alpha_draws(_alpha_layer.processed_draws, _alpha_layer.draw_bins);
+    }, { sort_alpha });
+}
+
+void SpriteBatcher::prepare_draws(const std::vector<SpriteDrawCall>& sprite_draws_in)
 {
-    SCOPED_EVENT("SpriteBatcher - convert draws", strtools::catf_temp("%d sprites", sprite_draws_in.size()));
+    SCOPED_EVENT("SpriteBatcher - prepare draws", strtools::catf_temp("%d sprites", sprite_draws_in.size()));
+
+    _sprite_draws_in = &sprite_draws_in;
+    _prepare_graph.run();
+    _sprite_draws_in = nullptr;
+}
 
+void SpriteBatcher::emit_prepared_draws(std::vector<DrawCall>& draws_out)
+{
     for (MaterialPool& pool : _material_pools | std::views::values)
     {
         pool.num_used = 0;
@@ -30,10 +82,16 @@ void SpriteBatcher::convert_draws(
 
     _buffer_pool.num_used = 0;
 
-    preprocess_draws(sprite_draws_in, _processed_draw_buffer);
-    sort_draws(_processed_draw_buffer);
-    bin_draws(_processed_draw_buffer, _draw_bin_buffer);
-    emit_draws(_draw_bin_buffer, draws_out);
+    // Translucent bins are emitted before opaque ones, which the draw call tree then orders by depth
+    emit_draws(_alpha_layer.draw_bins, draws_out);
+    emit_draws(_opaque_layer.draw_bins, draws_out);
+
+    // The prepared draws hold textures, whose last reference must be released on the main thread
+    for (DrawLayer* layer : { &_alpha_layer, &_opaque_layer })
+    {
+        layer->processed_draws.clear();
+        layer->draw_bins.clear();
+    }
 }
 
 void SpriteBatcher::flush()
@@ -88,18 +146,37 @@ bool SpriteBatcher::DrawBin::empty() const noexcept
     return _instance_data.empty();
 }
 
-void SpriteBatcher::preprocess_draws(
-    const std::vector<SpriteDrawCall>& sprite_draws_in,
+void SpriteBatcher::preprocess_draws(std::span<const SpriteDrawCall> sprite_draws_in, PreprocessedSlice& slice_out) const
+{
+    SCOPED_EVENT("SpriteBatcher - preprocess draws", strtools::catf_temp("%d sprites", sprite_draws_in.size()));
+    slice_out.opaque_draws.clear();
+    slice_out.alpha_draws.clear();
+
+    for (const SpriteDrawCall& sprite_draw : sprite_draws_in)
+    {
+        ProcessedSpriteDraw processed_draw = preprocess_draw(sprite_draw);
+        std::vector<ProcessedSpriteDraw>& layer_draws = processed_draw.requires_alpha
+            ? slice_out.alpha_draws
+            : slice_out.opaque_draws;
+
+        layer_draws.push_back(std::move(processed_draw));
+    }
+}
+
+void SpriteBatcher::gather_draws(
+    std::vector<ProcessedSpriteDraw> PreprocessedSlice::* slice_draws,
     std::vector<ProcessedSpriteDraw>& processed_draws_out
-) const
+)
 {
-    SCOPED_EVENT("SpriteBatcher - preprocess draws");
+    SCOPED_EVENT("SpriteBatcher - gather draws");
     processed_draws_out.clear();
-    processed_draws_out.reserve(sprite_draws_in.size());
 
-    for (const SpriteDrawCall& sprite_draw : sprite_draws_in)
+    // Slices are moved from so that the textures they hold aren't released here, off the main thread
+    for (PreprocessedSlice& slice : _preprocessed_slices)
     {
-        processed_draws_out.push_back(preprocess_draw(sprite_draw));
+        std::vector<ProcessedSpriteDraw>& draws = slice.*slice_draws;
+        std::ranges::move(draws, std::back_inserter(processed_draws_out));
+        draws.clear();
     }
 }
 
@@ -107,19 +184,42 @@ void SpriteBatcher::sort_draws(std::vector<ProcessedSpriteDraw>& processed_draws
 {
     SCOPED_EVENT("SpriteBatcher - sort draws");
 
-    std::sort(std::execution::par_unseq, processed_draws_in_out.begin(), processed_draws_in_out.end(),
+    threading::parallel_sort(processed_draws_in_out,
         [](const ProcessedSpriteDraw& x, const ProcessedSpriteDraw& y)
         {
             return x.z_depth < y.z_depth;
-        });
+        },
+        { .name = "sort draws" });
 }
 
-void SpriteBatcher::bin_draws(
+void SpriteBatcher::bin_opaque_draws(
     const std::vector<ProcessedSpriteDraw>& processed_draws_in,
     std::vector<DrawBin>& draw_bins_out
 ) const
 {
-    SCOPED_EVENT("SpriteBatcher - bin draws");
+    SCOPED_EVENT("SpriteBatcher - bin opaque draws");
+    draw_bins_out.clear();
+
+    // Opaque sprites can always be binned together if they have compatible textures
+    std::unordered_map<BinKey, DrawBin> opaque_bins;
+    for (const ProcessedSpriteDraw& processed_draw : processed_draws_in)
+    {
+        const BinKey bin_key = std::make_tuple(processed_draw.texture, false);
+        opaque_bins[bin_key].add_draw(processed_draw, bin_key);
+    }
+
+    for (DrawBin& opaque_bin : opaque_bins | std::views::values)
+    {
+        draw_bins_out.push_back(std::move(opaque_bin));
+    }
+}
+
+void SpriteBatcher::bin_alpha_draws(
+    const std::vector<ProcessedSpriteDraw>& processed_draws_in,
+    std::vector<DrawBin>& draw_bins_out
+) const
+{
+    SCOPED_EVENT("SpriteBatcher - bin alpha draws");
     draw_bins_out.clear();
 
     // Translucent sprites require that bins are broken such that two separate translucent
@@ -129,22 +229,10 @@ void SpriteBatcher::bin_draws(
     // 1. A single bin of any depth range
     // 2. Multiple bins with approximately flat and equal depth
     std::vector<DrawBin> alpha_bins;
-    std::unordered_map<BinKey, DrawBin> opaque_bins;
 
     for (const ProcessedSpriteDraw& processed_draw : processed_draws_in)
     {
-        const bool requires_alpha =
-            processed_draw.instance_data.color.w < 0.999f ||
-            processed_draw.texture->transparency() == TransparencyMode::translucent;
-
-        const BinKey bin_key = std::make_tuple(processed_draw.texture, requires_alpha);
-
-        // Opaque sprites can always be binned together if they have compatible textures
-        if (!requires_alpha)
-        {
-            opaque_bins[bin_key].add_draw(processed_draw, bin_key);
-            continue;
-        }
+        const BinKey bin_key = std::make_tuple(processed_draw.texture, true);
 
         // Create an alpha bin if there aren't any
         if (alpha_bins.empty())
@@ -212,10 +300,6 @@ void SpriteBatcher::bin_draws(
     }
 
     draw_bins_out.append_range(std::move(alpha_bins));
-    for (DrawBin& opaque_bin : opaque_bins | std::views::values)
-    {
-        draw_bins_out.push_back(std::move(opaque_bin));
-    }
 }
 
 void SpriteBatcher::emit_draws(const std::vector<DrawBin>& draw_bins_in, std::vector<DrawCall>& draws_out)
@@ -282,8 +366,11 @@ DrawCall SpriteBatcher::emit_instanced_draw(const DrawBin& draw_bin)
     if (requires_blend)
     {
         // Translucent sprites need to be drawn in reverse z-depth order
-        std::vector<SpriteInstanceData> reversed_instance_data(draw_bin.instance_data());
-        std::ranges::reverse(reversed_instance_data);
+        const std::vector<SpriteInstanceData>& instance_data = draw_bin.instance_data();
+        const std::pmr::vector<SpriteInstanceData> reversed_instance_data(
+            instance_data.rbegin(), instance_data.rend(),
+            memory::frame_resource()
+        );
 
         buffer->upload(reversed_instance_data);
     }
@@ -329,9 +416,14 @@ SpriteBatcher::ProcessedSpriteDraw SpriteBatcher::preprocess_draw(const SpriteDr
     const Vector2f tex_scale = Vector2f(sprite->resolution()) / texture_res;
     const Vector2f tex_offset = Vector2f(pos_corrected) / texture_res;
 
+    const bool requires_alpha =
+        sprite_draw.color.w < 0.999f ||
+        sprite->texture()->transparency() == TransparencyMode::translucent;
+
     return ProcessedSpriteDraw{
         .texture = sprite->texture(),
         .z_depth = mvp_matrix.get_translation().z,
+        .requires_alpha = requires_alpha,
         .instance_data = SpriteInstanceData{
             .color = sprite_draw.color,
             .mvp_matrix = mvp_matrix,
@@ -357,7 +449,7 @@ peng::shared_ref<Material> SpriteBatcher::get_pooled_material(const MaterialPool
 
     if (pool.num_used == pool.resources.size())
     {
-        peng::shared_ref<Material> new_material = peng::make_shared<Material>(
+        peng::shared_ref<Material> new_material = memory::make_pooled<Material>(
             [key]
             {
                 if (key == std::make_tuple(false, false))
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <span>
 #include <vector>
 #include <variant>
 #include <unordered_map>
@@ -7,6 +8,7 @@
 #include <memory/shared_ptr.h>
 #include <math/matrix4x4.h>
 #include <utils/hash_helpers.h>
+#include <threading/job_graph.h>
 
 #include "structured_buffer.h"
 
@@ -21,13 +23,23 @@ namespace rendering
 
     // Converts a set of sprite draw calls into regular draw calls
     // Where possible, batches sprites together into instanced draws
+    // Draws are prepared as a job graph, which may run on any thread. Slices of the draws are preprocessed
+    // concurrently and split into an opaque and a translucent layer, each of which is then sorted and binned
+    // concurrently with the other
+    // Emitting the prepared draws uses GL so must happen on the main thread
     class SpriteBatcher
     {
     public:
-        void convert_draws(
-            const std::vector<SpriteDrawCall>& sprite_draws_in,
-            std::vector<DrawCall>& draws_out
-        );
+        SpriteBatcher();
+
+        // The sprite draws are only read while preparing, so may be released once this returns
+        void prepare_draws(const std::vector<SpriteDrawCall>& sprite_draws_in);
+
+        // Emits draw calls for the sprites of the last prepare
+        void emit_prepared_draws(std::vector<DrawCall>& draws_out);
+
+        // The graph that prepares draws, whose timings are for the last prepare
+        [[nodiscard]] const threading::JobGraph& prepare_graph() const noexcept { return _prepare_graph; }
 
         // Frees internal resources that may no longer be in use
         // Should be used sparingly to avoid thrashing
@@ -47,6 +59,7 @@ namespace rendering
         {
             peng::shared_ref<const Texture> texture;
             float z_depth = 0;
+            bool requires_alpha = false;
             SpriteInstanceData instance_data;
         };
 
@@ -85,12 +98,34 @@ namespace rendering
             static constexpr float epsilon = 0.00001f;
         };
 
-        // Preprocess all of the sprite draw calls
+        // Draws of a preprocessed slice, split by whether they require alpha blending
+        struct PreprocessedSlice
+        {
+            std::vector<ProcessedSpriteDraw> opaque_draws;
+            std::vector<ProcessedSpriteDraw> alpha_draws;
+        };
+
+        // Opaque and translucent draws are sorted and binned independently of each other
+        struct DrawLayer
+        {
+            std::vector<ProcessedSpriteDraw> processed_draws;
+            std::vector<DrawBin> draw_bins;
+        };
+
+        static constexpr size_t max_preprocess_slices = 8;
+
+        // Preprocess a slice of the sprite draw calls
         void preprocess_draws(
-            const std::vector<SpriteDrawCall>& sprite_draws_in,
-            std::vector<ProcessedSpriteDraw>& processed_draws_out
+            std::span<const SpriteDrawCall> sprite_draws_in,
+            PreprocessedSlice& slice_out
         ) const;
 
+        // Gathers the draws of the layer from every slice, then sorts them by their z-depth
+        void gather_draws(
+            std::vector<ProcessedSpriteDraw> PreprocessedSlice::* slice_draws,
+            std::vector<ProcessedSpriteDraw>& processed_draws_out
+        );
+
         // Sorts draws by their z-depth
         void sort_draws(
             std::vector<ProcessedSpriteDraw>& processed_draws_in_out
@@ -98,8 +133,12 @@ namespace rendering
 
         // Bins processed draws by {texture, alpha}
         // This way all draws in a bin can be merged into one draw call
-        // Mutates the input for performance reasons
-        void bin_draws(
+        void bin_opaque_draws(
+            const std::vector<ProcessedSpriteDraw>& processed_draws_in,
+            std::vector<DrawBin>& draw_bins_out
+        ) const;
+
+        void bin_alpha_draws(
             const std::vector<ProcessedSpriteDraw>& processed_draws_in,
             std::vector<DrawBin>& draw_bins_out
         ) const;
@@ -125,7 +164,12 @@ namespace rendering
         peng::shared_ptr<const Mesh> _sprite_mesh;
         std::unordered_map<MaterialPoolKey, MaterialPool> _material_pools;
         ResourcePool<StructuredBuffer<SpriteInstanceData>> _buffer_pool;
-        std::vector<ProcessedSpriteDraw> _processed_draw_buffer;
-        std::vector<DrawBin> _draw_bin_buffer;
+        std::vector<PreprocessedSlice> _preprocessed_slices;
+        DrawLayer _opaque_layer;
+        DrawLayer _alpha_layer;
+
+        // Only set while the graph is running
+        const std::vector<SpriteDrawCall>* _sprite_draws_in;
+        threading::JobGraph _prepare_graph;
     };
 }
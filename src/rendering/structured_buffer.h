@@ -1,6 +1,6 @@
 #pragma once
 
-#include <vector>
+#include <span>
 #include <string>
 
 #include <profiling/scoped_event.h>
@@ -22,7 +22,7 @@ namespace rendering
         StructuredBuffer& operator=(const StructuredBuffer&) = delete;
         StructuredBuffer& operator=(StructuredBuffer&&) = delete;
 
-        void upload(const std::vector<T>& data);
+        void upload(std::span<const T> data);
 
         [[nodiscard]] GLuint get_ssbo() const override;
 
@@ -53,7 +53,7 @@ namespace rendering
     }
 
     template <typename T>
-    void StructuredBuffer<T>::upload(const std::vector<T>& data)
+    void StructuredBuffer<T>::upload(std::span<const T> data)
     {
         SCOPED_EVENT("StructuredBuffer - upload", _name.c_str());
 
@@ -16,6 +16,9 @@ namespace rendering
     class Texture
     {
     public:
+        // Textures are GL objects so must be destroyed with the GL context current, see memory::GC
+        static constexpr bool destroy_on_main_thread = true;
+
         struct Config
         {
             GLint wrap_x = GL_REPEAT;
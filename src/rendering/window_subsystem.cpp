@@ -204,7 +204,7 @@ void WindowSubsystem::tick(float)
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
-void WindowSubsystem::finalize_frame(float target_frametime)
+void WindowSubsystem::finalize_frame(float target_frametime, bool present)
 {
 	SCOPED_EVENT("PengEngine - finalize frame");
 
@@ -216,8 +216,11 @@ void WindowSubsystem::finalize_frame(float target_frametime)
 
 	_last_draw_time = sync_point;
 
-	SCOPED_GPU_EVENT("Finalize Frame");
-	glfwSwapBuffers(_window);
+	if (present)
+	{
+		SCOPED_GPU_EVENT("Finalize Frame");
+		glfwSwapBuffers(_window);
+	}
 }
 
 void WindowSubsystem::set_resolution(const math::Vector2i& resolution) noexcept
@@ -24,7 +24,8 @@ namespace rendering
         void shutdown() override;
         void tick(float delta_time) override;
 
-		void finalize_frame(float target_frametime);
+		// Waits out the rest of the frame and presents it, or leaves the last presented frame on screen if not presenting
+		void finalize_frame(float target_frametime, bool present = true);
 
 		void set_resolution(const math::Vector2i& resolution) noexcept;
 		void set_resolution(const math::Vector2i& resolution, bool fullscreen) noexcept;
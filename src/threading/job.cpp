@@ -2,17 +2,16 @@
 
 namespace threading
 {
-    Job::Job(std::function<void()> f)
-        : _f(f)
-    { }
-
     void Job::execute() const
     {
-        _f();
+        if (!is_empty())
+        {
+            (*this)();
+        }
     }
 
-    Job Job::empty()
+    Job Job::empty() noexcept
     {
-        return Job([] {});
+        return Job();
     }
-}
\ No newline at end of file
+}
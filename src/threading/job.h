@@ -1,18 +1,45 @@
 #pragma once
 
-#include <functional>
+#include <new>
+#include <utility>
+
+#include <memory/block_pool.h>
+#include <utils/delegate.h>
 
 namespace threading
 {
-    class Job
+    // Stores job captures too large to store inline in a block pool for their type, which only allocates while it grows
+    struct PooledFallback
+    {
+        template <typename F, typename...Args>
+        [[nodiscard]] static F* create(Args&&...args)
+        {
+            void* block = memory::block_pool<F>().allocate(sizeof(F), alignof(F));
+            return new (block) F(std::forward<Args>(args)...);
+        }
+
+        template <typename F>
+        static void destroy(F* f) noexcept
+        {
+            f->~F();
+            memory::block_pool<F>().deallocate(f);
+        }
+    };
+
+    // A move only unit of work for the worker threads and job system
+    // Captures that fit within inline_size and are nothrow movable are stored inline, so scheduling a job never
+    // allocates. Larger captures are stored through PooledFallback
+    class Job : public utils::Delegate<void(), 64, PooledFallback>
     {
     public:
-        Job(std::function<void()> f);
+        using Delegate::Delegate;
 
+        // Executing an empty job does nothing
         void execute() const;
-        static Job empty();
 
-    private:
-        std::function<void()> _f;
+        // An empty job, which is used to wake up workers without giving them any work
+        [[nodiscard]] static Job empty() noexcept;
+
+        [[nodiscard]] bool is_empty() const noexcept { return !*this; }
     };
-}
\ No newline at end of file
+}
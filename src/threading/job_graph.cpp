@@ -0,0 +1,175 @@
+#include "job_graph.h"
+
+#include <algorithm>
+
+#include <utils/check.h>
+#include <utils/strtools.h>
+#include <profiling/scoped_event.h>
+
+using namespace threading;
+
+JobGraph::JobGraph(std::string name, JobSystem& job_system)
+    : _name(std::move(name))
+    , _job_system(job_system)
+    , _run_time_ms(0)
+    , _critical_path_ms(0)
+{ }
+
+JobGraph::Node::Node(std::string&& name, Work&& work)
+    : name(std::move(name))
+    , work(std::move(work))
+    , pending_dependencies(0)
+{ }
+
+JobGraph::NodeId JobGraph::add_node(std::string name, Work&& work, std::initializer_list<NodeId> dependencies)
+{
+    return add_node(std::move(name), std::move(work), std::span(dependencies.begin(), dependencies.size()));
+}
+
+JobGraph::NodeId JobGraph::add_node(std::string name, Work&& work, std::span<const NodeId> dependencies)
+{
+    check(_jobs.done());
+
+    const NodeId id = static_cast<NodeId>(_nodes.size());
+    Node& node = _nodes.emplace_back(std::move(name), std::move(work));
+
+    for (const NodeId dependency : dependencies)
+    {
+        check(dependency < id);
+        node.dependencies.push_back(dependency);
+        _nodes[dependency].dependents.push_back(id);
+    }
+
+    if (node.dependencies.empty())
+    {
+        _roots.push_back(id);
+    }
+
+    _critical_path.reserve(_nodes.size());
+
+    return id;
+}
+
+void JobGraph::run()
+{
+    check(_jobs.done());
+
+    if (_nodes.empty())
+    {
+        return;
+    }
+
+    SCOPED_EVENT("JobGraph - run", _name.c_str());
+
+    for (Node& node : _nodes)
+    {
+        node.pending_dependencies.store(static_cast<int32_t>(node.dependencies.size()), std::memory_order_relaxed);
+    }
+
+    _run_start = timing::clock::now();
+
+    for (const NodeId root : _roots)
+    {
+        dispatch(root);
+    }
+
+    _job_system.wait(_jobs);
+    _run_time_ms = timing::duration_ms(timing::clock::now() - _run_start).count();
+
+    update_critical_path();
+}
+
+const std::string& JobGraph::node_name(NodeId node) const
+{
+    check(node < _nodes.size());
+    return _nodes[node].name;
+}
+
+double JobGraph::node_time_ms(NodeId node) const
+{
+    check(node < _nodes.size());
+    return timing::duration_ms(_nodes[node].end - _nodes[node].start).count();
+}
+
+void JobGraph::dispatch(NodeId node)
+{
+    _job_system.schedule(Job([this, node]
+    {
+        execute(node);
+    }), _jobs);
+}
+
+void JobGraph::execute(NodeId id)
+{
+    Node& node = _nodes[id];
+    node.start = timing::clock::now();
+
+    {
+        SCOPED_EVENT("JobGraph - node", strtools::catf_temp("%s: %s", _name.c_str(), node.name.c_str()));
+        node.work();
+    }
+
+    node.end = timing::clock::now();
+
+    // Dependents are scheduled before this job completes, so the graph isn't done until they are too
+    for (const NodeId dependent : node.dependents)
+    {
+        if (_nodes[dependent].pending_dependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            dispatch(dependent);
+        }
+    }
+}
+
+void JobGraph::update_critical_path()
+{
+    _critical_path.clear();
+
+    const auto ends_before = [this](NodeId x, NodeId y)
+    {
+        return _nodes[x].end < _nodes[y].end;
+    };
+
+    // Every node that finished last overall, or last among a node's dependencies, is what held up the rest
+    NodeId node = 0;
+    for (NodeId i = 1; i < _nodes.size(); i++)
+    {
+        if (ends_before(node, i))
+        {
+            node = i;
+        }
+    }
+
+    while (true)
+    {
+        _critical_path.push_back(node);
+
+        const std::vector<NodeId>& dependencies = _nodes[node].dependencies;
+        if (dependencies.empty())
+        {
+            break;
+        }
+
+        node = *std::ranges::max_element(dependencies, ends_before);
+    }
+
+    std::ranges::reverse(_critical_path);
+
+    // The description is rebuilt in place so that its storage is reused between runs
+    _critical_path_ms = 0;
+    _critical_path_description.clear();
+
+    for (const NodeId path_node : _critical_path)
+    {
+        if (!_critical_path_description.empty())
+        {
+            _critical_path_description += " > ";
+        }
+
+        const double time_ms = node_time_ms(path_node);
+        _critical_path_ms += time_ms;
+        _critical_path_description += strtools::catf_temp("%s %.3fms", _nodes[path_node].name.c_str(), time_ms);
+    }
+
+    _critical_path_description += strtools::catf_temp(" of %.3fms", _run_time_ms);
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <span>
+#include <deque>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <initializer_list>
+
+#include <utils/timing.h>
+#include <utils/delegate.h>
+
+#include "job_system.h"
+
+namespace threading
+{
+    // A graph of work where each node is dispatched to the job system as soon as all of its dependencies complete
+    // The graph is built once and can then be run any number of times, reusing all of its state between runs
+    //
+    // Every run records when each node started and finished, and finds the critical path of the run by following
+    // the dependencies that each node was last waiting on back from the last node to finish
+    // The path is measured as the time its nodes spent executing, and whatever is left of the run's time was spent
+    // waiting for the path's nodes to be picked up by a thread
+    class JobGraph
+    {
+    public:
+        using NodeId = uint32_t;
+        using Work = utils::Delegate<void()>;
+
+        explicit JobGraph(std::string name, JobSystem& job_system = JobSystem::get());
+        JobGraph(const JobGraph&) = delete;
+        JobGraph(JobGraph&&) = delete;
+
+        // Dependencies must already be in the graph, so that it can never contain a cycle
+        NodeId add_node(std::string name, Work&& work, std::initializer_list<NodeId> dependencies = {});
+        NodeId add_node(std::string name, Work&& work, std::span<const NodeId> dependencies);
+
+        // Runs every node, helping to execute jobs until all of them are complete
+        void run();
+
+        [[nodiscard]] size_t size() const noexcept { return _nodes.size(); }
+        [[nodiscard]] const std::string& name() const noexcept { return _name; }
+        [[nodiscard]] const std::string& node_name(NodeId node) const;
+
+        // Timings are for the last run
+        [[nodiscard]] double node_time_ms(NodeId node) const;
+        [[nodiscard]] double run_time_ms() const noexcept { return _run_time_ms; }
+        [[nodiscard]] std::span<const NodeId> critical_path() const noexcept { return _critical_path; }
+        [[nodiscard]] double critical_path_ms() const noexcept { return _critical_path_ms; }
+
+        // Names each node on the critical path along with its time, such as "a 1.000ms > b 2.000ms of 3.500ms"
+        [[nodiscard]] const std::string& critical_path_description() const noexcept { return _critical_path_description; }
+
+    private:
+        struct Node
+        {
+            Node(std::string&& name, Work&& work);
+
+            std::string name;
+            Work work;
+            std::vector<NodeId> dependencies;
+            std::vector<NodeId> dependents;
+
+            std::atomic<int32_t> pending_dependencies;
+            timing::clock::time_point start;
+            timing::clock::time_point end;
+        };
+
+        void dispatch(NodeId node);
+        void execute(NodeId node);
+        void update_critical_path();
+
+        std::string _name;
+        JobSystem& _job_system;
+        JobCounter _jobs;
+
+        std::deque<Node> _nodes;
+        std::vector<NodeId> _roots;
+
+        timing::clock::time_point _run_start;
+        double _run_time_ms;
+        std::vector<NodeId> _critical_path;
+        double _critical_path_ms;
+        std::string _critical_path_description;
+    };
+}
@@ -0,0 +1,275 @@
+#include "job_system.h"
+
+#include <utils/check.h>
+#include <utils/strtools.h>
+#include <profiling/scoped_event.h>
+
+#include "thread_name.h"
+
+using namespace threading;
+
+namespace
+{
+    struct WorkerContext
+    {
+        const JobSystem* system = nullptr;
+        size_t index = 0;
+    };
+
+    thread_local WorkerContext current_context;
+    thread_local JobSystem::IdleWork current_idle_work;
+
+    // Cheap per thread randomness to spread out which workers are stolen from
+    uint32_t next_random() noexcept
+    {
+        thread_local uint32_t state = static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id())) | 1;
+
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+
+        return state;
+    }
+}
+
+JobSystem::JobSystem(size_t num_workers)
+    : _running(true)
+    , _num_queued(0)
+    , _num_sleeping(0)
+{
+    _workers.reserve(num_workers);
+    for (size_t i = 0; i < num_workers; i++)
+    {
+        _workers.push_back(std::make_unique<Worker>());
+    }
+
+    // Workers are only started once they all exist, as they steal from each other
+    for (size_t i = 0; i < num_workers; i++)
+    {
+        _workers[i]->thread = std::thread([this, i]
+        {
+            current_context = { this, i };
+            set_current_thread_name(strtools::catf("JobWorker_%d", static_cast<int32_t>(i)));
+
+            worker_routine(i);
+        });
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard lock(_sleep_mutex);
+        _running = false;
+    }
+
+    _sleep_cv.notify_all();
+
+    for (const std::unique_ptr<Worker>& worker : _workers)
+    {
+        worker->thread.join();
+    }
+
+    check(_num_queued == 0);
+}
+
+void JobSystem::schedule(Job&& job, JobCounter& counter)
+{
+    counter._pending.fetch_add(1, std::memory_order_relaxed);
+
+    const size_t worker = current_worker();
+    WorkStealingQueue<Entry>& queue = worker != no_worker
+        ? _workers[worker]->queue
+        : _shared_queue;
+
+    // Counted before it's published, so that a thief finishing it straight away can never take the count below zero
+    // A worker that sees the count first just retries until the job lands
+    _num_queued.fetch_add(1);
+
+    queue.push(Entry{
+        .job = std::move(job),
+        .counter = &counter
+    });
+
+    // Sleeping workers count themselves before checking for jobs, so either they see this job or we see them
+    if (_num_sleeping.load() > 0)
+    {
+        std::lock_guard lock(_sleep_mutex);
+        _sleep_cv.notify_one();
+    }
+}
+
+void JobSystem::wait(JobCounter& counter)
+{
+    if (counter.done())
+    {
+        return;
+    }
+
+    SCOPED_EVENT("JobSystem - wait", strtools::catf_temp("%d pending", counter.pending()));
+
+    const size_t worker = current_worker();
+    while (!counter.done())
+    {
+        // Nothing left to help with means the last jobs are already running elsewhere
+        if (!try_execute(worker) && !try_idle_work())
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::set_idle_work(IdleWork&& work)
+{
+    current_idle_work = std::move(work);
+}
+
+void JobSystem::clear_idle_work() noexcept
+{
+    current_idle_work.reset();
+}
+
+size_t JobSystem::default_num_workers()
+{
+    const uint32_t threads = std::thread::hardware_concurrency();
+    // Unknown or single core machines still get a worker, so that jobs run alongside a thread waiting on them
+    return threads > 1
+        ? threads - 1
+        : 1;
+}
+
+size_t JobSystem::current_worker() const noexcept
+{
+    return current_context.system == this
+        ? current_context.index
+        : no_worker;
+}
+
+std::optional<JobSystem::Entry> JobSystem::find_job(size_t worker)
+{
+    if (_num_queued.load(std::memory_order_relaxed) == 0)
+    {
+        return std::nullopt;
+    }
+
+    if (worker != no_worker)
+    {
+        if (std::optional<Entry> entry = _workers[worker]->queue.pop())
+        {
+            return entry;
+        }
+    }
+
+    if (std::optional<Entry> entry = _shared_queue.steal())
+    {
+        return entry;
+    }
+
+    // Starting from a random victim stops every idle worker from contending over the same queue
+    const size_t num_workers = _workers.size();
+    const size_t first_victim = num_workers > 0 ? next_random() % num_workers : 0;
+
+    for (size_t i = 0; i < num_workers; i++)
+    {
+        const size_t victim = (first_victim + i) % num_workers;
+        if (victim == worker)
+        {
+            continue;
+        }
+
+        if (std::optional<Entry> entry = _workers[victim]->queue.steal())
+        {
+            return entry;
+        }
+    }
+
+    return std::nullopt;
+}
+
+bool JobSystem::try_execute(size_t worker)
+{
+    std::optional<Entry> entry = find_job(worker);
+    if (!entry)
+    {
+        return false;
+    }
+
+    _num_queued.fetch_sub(1);
+    execute(std::move(*entry));
+
+    return true;
+}
+
+bool JobSystem::try_idle_work()
+{
+    if (!current_idle_work)
+    {
+        return false;
+    }
+
+    // Taken out while it runs, so that any waits within it don't run it again
+    IdleWork work = std::move(current_idle_work);
+    if (work())
+    {
+        return true;
+    }
+
+    // Work installed while it ran replaces it
+    if (!current_idle_work)
+    {
+        current_idle_work = std::move(work);
+    }
+
+    return false;
+}
+
+void JobSystem::execute(Entry&& entry)
+{
+    JobCounter& counter = *entry.counter;
+
+    // The job is released before completing so that nothing it captured outlives the wait on it
+    {
+        const Job job = std::move(entry.job);
+        job.execute();
+    }
+
+    counter._pending.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void JobSystem::worker_routine(size_t worker)
+{
+    // Spinning briefly before sleeping avoids the cost of a wake up when jobs are scheduled in quick succession
+    constexpr int32_t spins_before_sleep = 64;
+
+    while (true)
+    {
+        bool found_job = false;
+        for (int32_t spin = 0; spin < spins_before_sleep && !found_job; spin++)
+        {
+            found_job = try_execute(worker);
+            if (!found_job)
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        if (found_job)
+        {
+            continue;
+        }
+
+        std::unique_lock lock(_sleep_mutex);
+        if (!_running && _num_queued == 0)
+        {
+            return;
+        }
+
+        _num_sleeping++;
+        _sleep_cv.wait(lock, [this]
+        {
+            return _num_queued > 0 || !_running;
+        });
+
+        _num_sleeping--;
+    }
+}
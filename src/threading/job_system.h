@@ -0,0 +1,106 @@
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include <condition_variable>
+
+#include <utils/singleton.h>
+
+#include "job.h"
+#include "work_stealing_queue.h"
+
+namespace threading
+{
+    // Counts the jobs scheduled against it that are yet to complete, so that they can be waited on together
+    // Jobs may schedule more jobs against the counter they were scheduled with, which are then waited on too
+    class JobCounter
+    {
+    public:
+        JobCounter() = default;
+        JobCounter(const JobCounter&) = delete;
+        JobCounter(JobCounter&&) = delete;
+
+        [[nodiscard]] bool done() const noexcept { return pending() == 0; }
+        [[nodiscard]] int32_t pending() const noexcept { return _pending.load(std::memory_order_acquire); }
+
+    private:
+        friend class JobSystem;
+
+        std::atomic<int32_t> _pending = 0;
+    };
+
+    // Runs jobs on a fixed set of workers that each own a queue, and steal from each other once theirs is empty
+    // Jobs scheduled by a worker go to its own queue, and those scheduled by any other thread to a shared queue
+    // Threads waiting on a counter execute other jobs until it completes, so waiting from within a job can't deadlock
+    //
+    // The engine shares the instance returned by get, but separate instances may be created for isolated work
+    class JobSystem : public utils::Singleton<JobSystem>
+    {
+    public:
+        explicit JobSystem(size_t num_workers = default_num_workers());
+        ~JobSystem();
+
+        void schedule(Job&& job, JobCounter& counter);
+
+        // Blocks until every job scheduled against the counter has completed, executing other jobs in the meantime
+        void wait(JobCounter& counter);
+
+        // Work that returns whether it could run, and is otherwise tried again later
+        using IdleWork = utils::Delegate<bool()>;
+
+        // Gives the calling thread work to run once while it waits on jobs and has none of them left to execute,
+        // such as work that can only happen on that thread. It stays installed until it runs or is cleared
+        static void set_idle_work(IdleWork&& work);
+        static void clear_idle_work() noexcept;
+
+        [[nodiscard]] size_t num_workers() const noexcept { return _workers.size(); }
+
+        // The number of threads that can execute jobs at once, including a thread that is waiting on them
+        [[nodiscard]] size_t concurrency() const noexcept { return _workers.size() + 1; }
+
+        [[nodiscard]] size_t num_pending_jobs() const noexcept { return _num_queued.load(std::memory_order_relaxed); }
+
+        // Leaves a core for the main thread, which executes jobs itself while waiting on them
+        [[nodiscard]] static size_t default_num_workers();
+
+    private:
+        struct Entry
+        {
+            Job job;
+            JobCounter* counter;
+        };
+
+        struct Worker
+        {
+            WorkStealingQueue<Entry> queue;
+            std::thread thread;
+        };
+
+        static constexpr size_t no_worker = SIZE_MAX;
+
+        // The index of the calling thread if it is one of our workers, or no_worker otherwise
+        [[nodiscard]] size_t current_worker() const noexcept;
+
+        [[nodiscard]] std::optional<Entry> find_job(size_t worker);
+        bool try_execute(size_t worker);
+        void execute(Entry&& entry);
+
+        static bool try_idle_work();
+
+        void worker_routine(size_t worker);
+
+        std::vector<std::unique_ptr<Worker>> _workers;
+        WorkStealingQueue<Entry> _shared_queue;
+
+        std::atomic<bool> _running;
+        std::atomic<size_t> _num_queued;
+        std::atomic<int32_t> _num_sleeping;
+        std::mutex _sleep_mutex;
+        std::condition_variable _sleep_cv;
+    };
+}
@@ -0,0 +1,226 @@
+#pragma once
+
+#include <ranges>
+#include <cstddef>
+#include <concepts>
+#include <algorithm>
+#include <functional>
+#include <memory_resource>
+
+#include <memory/frame_arena.h>
+#include <profiling/scoped_event.h>
+#include <utils/strtools.h>
+
+#include "job_system.h"
+
+namespace threading
+{
+    struct ParallelOptions
+    {
+        // The most items handed to each job, or 0 to split the items evenly between the job system's threads
+        // Smaller grains balance uneven work better at the cost of scheduling more jobs
+        size_t grain_size = 0;
+
+        // Identifies the work in the profiler event of each chunk
+        const char* name = "";
+
+        // The engine's job system is used if none is given
+        JobSystem* job_system = nullptr;
+    };
+
+    // Invokes f(begin, end) for chunks that cover the indices [0, count), blocking until all of them are done
+    // The calling thread executes the last chunk itself and then helps with the rest
+    template <typename F>
+    requires std::invocable<F&, size_t, size_t>
+    void parallel_for_chunks(size_t count, F&& f, const ParallelOptions& options = {});
+
+    // Invokes f(item) for every item in the range
+    template <std::ranges::random_access_range R, typename F>
+    requires std::ranges::sized_range<R> && std::invocable<F&, std::ranges::range_reference_t<R>>
+    void parallel_for(R&& range, F&& f, const ParallelOptions& options = {});
+
+    // Combines transform(item) for every item in the range using reduce, starting from identity
+    // Each chunk is reduced separately before the chunk results are reduced in order, so reduce must be associative
+    template <std::ranges::random_access_range R, typename T, typename Transform, typename Reduce>
+    requires std::ranges::sized_range<R>
+    [[nodiscard]] T parallel_reduce(R&& range, T identity, Transform&& transform, Reduce&& reduce, const ParallelOptions& options = {});
+
+    // Sorts chunks of the range concurrently, then merges neighbouring chunks in concurrent passes
+    // The grain size is the smallest chunk worth sorting separately, below which the range is sorted on one thread
+    // The sort is not stable
+    template <std::ranges::random_access_range R, typename Compare = std::ranges::less>
+    requires std::ranges::sized_range<R>
+    void parallel_sort(R&& range, Compare&& compare = {}, const ParallelOptions& options = {});
+
+    namespace detail
+    {
+        [[nodiscard]] inline JobSystem& job_system_of(const ParallelOptions& options)
+        {
+            return options.job_system
+                ? *options.job_system
+                : JobSystem::get();
+        }
+
+        [[nodiscard]] inline size_t num_chunks(size_t count, size_t grain_size, const JobSystem& job_system) noexcept
+        {
+            return grain_size > 0
+                ? (count + grain_size - 1) / grain_size
+                : std::min(count, job_system.concurrency());
+        }
+
+        [[nodiscard]] inline size_t chunk_begin(size_t count, size_t num_chunks, size_t chunk) noexcept
+        {
+            return count * chunk / num_chunks;
+        }
+
+        // Invokes f(chunk, begin, end) for each of num_chunks chunks, which must be at least 1
+        template <typename F>
+        void run_chunks(size_t count, size_t num_chunks, F&& f, const ParallelOptions& options)
+        {
+            const auto run_chunk = [&f, &options, count, num_chunks](size_t chunk)
+            {
+                const size_t begin = chunk_begin(count, num_chunks, chunk);
+                const size_t end = chunk_begin(count, num_chunks, chunk + 1);
+
+                SCOPED_EVENT("Parallel - chunk", strtools::catf_temp("%s: %zu to %zu", options.name, begin, end));
+                f(chunk, begin, end);
+            };
+
+            if (num_chunks == 1)
+            {
+                run_chunk(0);
+                return;
+            }
+
+            JobSystem& job_system = job_system_of(options);
+            JobCounter counter;
+
+            for (size_t chunk = 0; chunk + 1 < num_chunks; chunk++)
+            {
+                job_system.schedule(Job([&run_chunk, chunk]
+                {
+                    run_chunk(chunk);
+                }), counter);
+            }
+
+            run_chunk(num_chunks - 1);
+            job_system.wait(counter);
+        }
+    }
+
+    template <typename F>
+    requires std::invocable<F&, size_t, size_t>
+    void parallel_for_chunks(size_t count, F&& f, const ParallelOptions& options)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        const size_t num_chunks = detail::num_chunks(count, options.grain_size, detail::job_system_of(options));
+        detail::run_chunks(count, num_chunks, [&f](size_t, size_t begin, size_t end)
+        {
+            f(begin, end);
+        }, options);
+    }
+
+    template <std::ranges::random_access_range R, typename F>
+    requires std::ranges::sized_range<R> && std::invocable<F&, std::ranges::range_reference_t<R>>
+    void parallel_for(R&& range, F&& f, const ParallelOptions& options)
+    {
+        const auto first = std::ranges::begin(range);
+
+        parallel_for_chunks(std::ranges::size(range), [&f, &first](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                f(first[i]);
+            }
+        }, options);
+    }
+
+    template <std::ranges::random_access_range R, typename T, typename Transform, typename Reduce>
+    requires std::ranges::sized_range<R>
+    T parallel_reduce(R&& range, T identity, Transform&& transform, Reduce&& reduce, const ParallelOptions& options)
+    {
+        const size_t count = std::ranges::size(range);
+        if (count == 0)
+        {
+            return identity;
+        }
+
+        const auto first = std::ranges::begin(range);
+        const size_t num_chunks = detail::num_chunks(count, options.grain_size, detail::job_system_of(options));
+
+        // Chunk results only live until the end of the call, so come from the frame arena of the calling thread
+        std::pmr::vector<T> chunk_results(num_chunks, identity, memory::frame_resource());
+
+        detail::run_chunks(count, num_chunks, [&](size_t chunk, size_t begin, size_t end)
+        {
+            T result = identity;
+            for (size_t i = begin; i < end; i++)
+            {
+                result = reduce(std::move(result), transform(first[i]));
+            }
+
+            chunk_results[chunk] = std::move(result);
+        }, options);
+
+        T result = std::move(identity);
+        for (T& chunk_result : chunk_results)
+        {
+            result = reduce(std::move(result), std::move(chunk_result));
+        }
+
+        return result;
+    }
+
+    template <std::ranges::random_access_range R, typename Compare>
+    requires std::ranges::sized_range<R>
+    void parallel_sort(R&& range, Compare&& compare, const ParallelOptions& options)
+    {
+        constexpr size_t default_min_chunk_size = 2048;
+
+        const auto first = std::ranges::begin(range);
+        const size_t count = std::ranges::size(range);
+        const size_t min_chunk_size = options.grain_size > 0 ? options.grain_size : default_min_chunk_size;
+
+        const size_t num_chunks = std::min(count / min_chunk_size, detail::job_system_of(options).concurrency());
+        if (num_chunks <= 1)
+        {
+            std::sort(first, first + count, compare);
+            return;
+        }
+
+        detail::run_chunks(count, num_chunks, [&](size_t, size_t begin, size_t end)
+        {
+            std::sort(first + begin, first + end, compare);
+        }, options);
+
+        // Each pass merges pairs of neighbouring runs, doubling the width of the sorted runs
+        const auto run_begin = [&](size_t chunk)
+        {
+            return first + detail::chunk_begin(count, num_chunks, std::min(chunk, num_chunks));
+        };
+
+        for (size_t width = 1; width < num_chunks; width *= 2)
+        {
+            const size_t num_merges = (num_chunks + 2 * width - 1) / (2 * width);
+
+            ParallelOptions merge_options = options;
+            merge_options.grain_size = 1;
+
+            parallel_for_chunks(num_merges, [&](size_t begin, size_t end)
+            {
+                for (size_t merge = begin; merge < end; merge++)
+                {
+                    const size_t left = merge * 2 * width;
+                    if (left + width < num_chunks)
+                    {
+                        std::inplace_merge(run_begin(left), run_begin(left + width), run_begin(left + 2 * width), compare);
+                    }
+                }
+            }, merge_options);
+        }
+    }
+}
@@ -0,0 +1,23 @@
+#include "thread_name.h"
+
+#ifdef _WIN32
+#pragma warning( push, 0 )
+#include <windows.h>
+#pragma warning( pop )
+#else
+#include <pthread.h>
+#endif
+
+void threading::set_current_thread_name(const std::string& name)
+{
+#ifdef _WIN32
+    if (GetProcAddress(GetModuleHandle(L"kernel32.dll"), "SetThreadDescription"))
+    {
+        const std::wstring w_name = std::wstring(name.begin(), name.end());
+        SetThreadDescription(GetCurrentThread(), w_name.c_str());
+    }
+#else
+    // Names are limited to 15 characters plus the terminator
+    pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+#endif
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <string>
+
+namespace threading
+{
+    // Names the calling thread so that it can be identified in debuggers and profilers
+    void set_current_thread_name(const std::string& name);
+}
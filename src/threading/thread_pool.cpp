@@ -2,6 +2,8 @@
 
 #include <utils/strtools.h>
 
+#include "thread_name.h"
+
 namespace threading
 {
     ThreadPool::ThreadPool(const size_t worker_count)
@@ -60,7 +62,8 @@ namespace threading
 
     void ThreadPool::create_worker()
     {
-        _workers.emplace_back([&] {
+        _workers.emplace_back([this, name = get_thread_name()] {
+            set_current_thread_name(name);
             worker_routine();
         });
     }
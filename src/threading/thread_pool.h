@@ -21,10 +21,10 @@ namespace threading
         void schedule_job(Job&& job);
         void shutdown();
 
-        // TODO: make this get used
         virtual std::string get_thread_name() const noexcept;
 
         [[nodiscard]] bool running() const noexcept { return _running; }
+        [[nodiscard]] size_t max_workers() const noexcept { return _max_workers; }
         [[nodiscard]] size_t num_pending_jobs() const noexcept { return _num_pending_jobs; }
         [[nodiscard]] size_t num_executing_jobs() const noexcept { return _num_busy_workers; }
 
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <mutex>
+#include <vector>
+#include <optional>
+
+namespace threading
+{
+    // A double ended queue of work owned by a single worker
+    // The owner pushes and pops at the back, so it works on its most recent and cache warm work first, while other
+    // workers steal from the front, taking the oldest work which tends to be the largest
+    // The lock is only contended while stealing, and the buffer grows as needed but never shrinks
+    template <typename T>
+    class WorkStealingQueue
+    {
+    public:
+        WorkStealingQueue();
+        WorkStealingQueue(const WorkStealingQueue&) = delete;
+        WorkStealingQueue(WorkStealingQueue&&) = delete;
+
+        void push(T&& value);
+
+        [[nodiscard]] std::optional<T> pop();
+        [[nodiscard]] std::optional<T> steal();
+
+    private:
+        // Must be called with the mutex held
+        void grow();
+
+        static constexpr size_t initial_capacity = 64;
+
+        std::mutex _mutex;
+        std::vector<std::optional<T>> _buffer;
+
+        // Both only ever increase, and are wrapped into the buffer whose capacity is a power of two
+        size_t _head;
+        size_t _tail;
+    };
+
+    template <typename T>
+    WorkStealingQueue<T>::WorkStealingQueue()
+        : _buffer(initial_capacity)
+        , _head(0)
+        , _tail(0)
+    { }
+
+    template <typename T>
+    void WorkStealingQueue<T>::push(T&& value)
+    {
+        std::lock_guard lock(_mutex);
+
+        if (_tail - _head == _buffer.size())
+        {
+            grow();
+        }
+
+        _buffer[_tail++ & (_buffer.size() - 1)] = std::move(value);
+    }
+
+    template <typename T>
+    std::optional<T> WorkStealingQueue<T>::pop()
+    {
+        std::lock_guard lock(_mutex);
+
+        if (_head == _tail)
+        {
+            return std::nullopt;
+        }
+
+        std::optional<T>& slot = _buffer[--_tail & (_buffer.size() - 1)];
+        std::optional<T> value = std::move(slot);
+        slot.reset();
+
+        return value;
+    }
+
+    template <typename T>
+    std::optional<T> WorkStealingQueue<T>::steal()
+    {
+        std::lock_guard lock(_mutex);
+
+        if (_head == _tail)
+        {
+            return std::nullopt;
+        }
+
+        std::optional<T>& slot = _buffer[_head++ & (_buffer.size() - 1)];
+        std::optional<T> value = std::move(slot);
+        slot.reset();
+
+        return value;
+    }
+
+    template <typename T>
+    void WorkStealingQueue<T>::grow()
+    {
+        std::vector<std::optional<T>> buffer(_buffer.size() * 2);
+        for (size_t i = _head; i < _tail; i++)
+        {
+            buffer[i & (buffer.size() - 1)] = std::move(_buffer[i & (_buffer.size() - 1)]);
+        }
+
+        _buffer = std::move(buffer);
+    }
+}
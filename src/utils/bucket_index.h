@@ -0,0 +1,70 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <unordered_map>
+
+#include "check.h"
+
+namespace utils
+{
+    // Maps keys to unordered buckets of items with O(1) insertion and removal
+    // Each item stores its position within its bucket, accessed through SlotAccessor::get(item), so it can be
+    // swap-and-popped out of the bucket. A slot of -1 means the item is not in the index
+    template <typename Key, typename T, typename SlotAccessor, typename Hash = std::hash<Key>>
+    class BucketIndex
+    {
+    public:
+        void add(const Key& key, T& item)
+        {
+            check(SlotAccessor::get(item) < 0);
+
+            std::vector<T*>& bucket = _buckets[key];
+            SlotAccessor::get(item) = static_cast<int32_t>(bucket.size());
+            bucket.push_back(&item);
+        }
+
+        void remove(const Key& key, T& item)
+        {
+            const auto it = _buckets.find(key);
+            check(it != _buckets.end());
+
+            std::vector<T*>& bucket = it->second;
+            const int32_t slot = SlotAccessor::get(item);
+            check(slot >= 0 && slot < static_cast<int32_t>(bucket.size()) && bucket[slot] == &item);
+
+            // Empty buckets are kept around so that their storage can be reused
+            bucket[slot] = bucket.back();
+            SlotAccessor::get(*bucket[slot]) = slot;
+            bucket.pop_back();
+
+            SlotAccessor::get(item) = -1;
+        }
+
+        [[nodiscard]] std::span<T* const> find(const Key& key) const
+        {
+            if (const auto it = _buckets.find(key); it != _buckets.end())
+            {
+                return it->second;
+            }
+
+            return {};
+        }
+
+        void clear()
+        {
+            for (auto& [key, bucket] : _buckets)
+            {
+                for (T* item : bucket)
+                {
+                    SlotAccessor::get(*item) = -1;
+                }
+            }
+
+            _buckets.clear();
+        }
+
+    private:
+        std::unordered_map<Key, std::vector<T*>, Hash> _buckets;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <new>
+#include <cstddef>
+#include <utility>
+#include <concepts>
+#include <type_traits>
+
+namespace utils
+{
+    // Stores callables too large to store inline in a delegate on the heap
+    // Other fallbacks provide the same create and destroy functions to store them elsewhere
+    struct HeapFallback
+    {
+        template <typename F, typename...Args>
+        [[nodiscard]] static F* create(Args&&...args)
+        {
+            return new F(std::forward<Args>(args)...);
+        }
+
+        template <typename F>
+        static void destroy(F* f) noexcept
+        {
+            delete f;
+        }
+    };
+
+    template <typename Signature, size_t InlineSize = 4 * sizeof(void*), typename Fallback = HeapFallback>
+    class Delegate;
+
+    // A move only type erased callable, similar to std::function
+    // Callables that fit within InlineSize and are nothrow movable are stored inline without any heap allocation,
+    // which covers lambdas capturing a few pointers or handles. Larger callables are stored through the Fallback
+    template <typename R, typename...Args, size_t InlineSize, typename Fallback>
+    class Delegate<R(Args...), InlineSize, Fallback>
+    {
+    public:
+        static constexpr size_t inline_size = InlineSize;
+
+        Delegate() noexcept = default;
+
+        template <typename F>
+        requires (!std::derived_from<std::remove_cvref_t<F>, Delegate>) && std::invocable<std::remove_cvref_t<F>&, Args...>
+        Delegate(F&& f);
+
+        Delegate(Delegate&& other) noexcept;
+        Delegate(const Delegate&) = delete;
+        ~Delegate();
+
+        Delegate& operator=(Delegate&& other) noexcept;
+        Delegate& operator=(const Delegate&) = delete;
+
+        // Must not be called on an empty delegate
+        // Delegates underlie jobs, which the logger depends on, so this can't check without an include cycle
+        R operator()(Args...args) const;
+
+        void reset() noexcept;
+
+        [[nodiscard]] explicit operator bool() const noexcept { return _ops != nullptr; }
+
+        template <typename F>
+        static constexpr bool stored_inline =
+            sizeof(F) <= InlineSize
+            && alignof(F) <= alignof(std::max_align_t)
+            && std::is_nothrow_move_constructible_v<F>;
+
+    private:
+        struct Ops
+        {
+            R (*invoke)(void* storage, Args&&...args);
+            void (*move)(void* dst, void* src) noexcept;
+            void (*destroy)(void* storage) noexcept;
+        };
+
+        template <typename F>
+        static constexpr Ops inline_ops = {
+            [](void* storage, Args&&...args) -> R
+            {
+                return (*static_cast<F*>(storage))(std::forward<Args>(args)...);
+            },
+            [](void* dst, void* src) noexcept
+            {
+                new (dst) F(std::move(*static_cast<F*>(src)));
+                static_cast<F*>(src)->~F();
+            },
+            [](void* storage) noexcept
+            {
+                static_cast<F*>(storage)->~F();
+            }
+        };
+
+        // Callables too large to store inline are stored by the fallback, with the storage holding the pointer
+        template <typename F>
+        static constexpr Ops fallback_ops = {
+            [](void* storage, Args&&...args) -> R
+            {
+                return (**static_cast<F**>(storage))(std::forward<Args>(args)...);
+            },
+            [](void* dst, void* src) noexcept
+            {
+                *static_cast<F**>(dst) = *static_cast<F**>(src);
+            },
+            [](void* storage) noexcept
+            {
+                Fallback::destroy(*static_cast<F**>(storage));
+            }
+        };
+
+        alignas(std::max_align_t) mutable std::byte _storage[InlineSize];
+        const Ops* _ops = nullptr;
+    };
+
+    template <typename R, typename...Args, size_t InlineSize, typename Fallback>
+    template <typename F>
+    requires (!std::derived_from<std::remove_cvref_t<F>, Delegate<R(Args...), InlineSize, Fallback>>)
+        && std::invocable<std::remove_cvref_t<F>&, Args...>
+    Delegate<R(Args...), InlineSize, Fallback>::Delegate(F&& f)
+    {
+        using callable = std::remove_cvref_t<F>;
+
+        if constexpr (stored_inline<callable>)
+        {
+            new (_storage) callable(std::forward<F>(f));
+            _ops = &inline_ops<callable>;
+        }
+        else
+        {
+            *reinterpret_cast<callable**>(_storage) = Fallback::template create<callable>(std::forward<F>(f));
+            _ops = &fallback_ops<callable>;
+        }
+    }
+
+    template <typename R, typename...Args, size_t InlineSize, typename Fallback>
+    Delegate<R(Args...), InlineSize, Fallback>::Delegate(Delegate&& other) noexcept
+        : _ops(std::exchange(other._ops, nullptr))
+    {
+        if (_ops)
+        {
+            _ops->move(_storage, other._storage);
+        }
+    }
+
+    template <typename R, typename...Args, size_t InlineSize, typename Fallback>
+    Delegate<R(Args...), InlineSize, Fallback>::~Delegate()
+    {
+        reset();
+    }
+
+    template <typename R, typename...Args, size_t InlineSize, typename Fallback>
+    Delegate<R(Args...), InlineSize, Fallback>& Delegate<R(Args...), InlineSize, Fallback>::operator=(Delegate&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+
+            _ops = std::exchange(other._ops, nullptr);
+            if (_ops)
+            {
+                _ops->move(_storage, other._storage);
+            }
+        }
+
+        return *this;
+    }
+
+    template <typename R, typename...Args, size_t InlineSize, typename Fallback>
+    R Delegate<R(Args...), InlineSize, Fallback>::operator()(Args...args) const
+    {
+        return _ops->invoke(_storage, std::forward<Args>(args)...);
+    }
+
+    template <typename R, typename...Args, size_t InlineSize, typename Fallback>
+    void Delegate<R(Args...), InlineSize, Fallback>::reset() noexcept
+    {
+        if (_ops)
+        {
+            _ops->destroy(_storage);
+            _ops = nullptr;
+        }
+    }
+}
@@ -1,43 +1,80 @@
 #pragma once
 
+#include <bit>
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <limits>
 #include <vector>
-#include <functional>
-#include <tuple>
-#include <string>
+#include <cstdint>
 
 #include "check.h"
-#include "vectools.h"
+#include "delegate.h"
 
 namespace utils
 {
+    // A multicast event that may be subscribed to, unsubscribed from and invoked from any thread
+    // Listeners are stored in chunks that never move, and invoking only reads them without taking a lock
+    // Listeners that unsubscribe while the event is being invoked are kept alive until every invocation has finished
+    // A listener subscribed during an invocation may or may not be invoked by it
     template <typename...Args>
     class EventInterface
     {
     public:
-        using invocable = std::function<void(Args...)>;
-        using listener_handle = int32_t;
-        using named_listener = std::tuple<invocable, std::string, listener_handle>;
+        using invocable = Delegate<void(Args...)>;
+        using listener_handle = uint64_t;
 
-        listener_handle subscribe(invocable&& listener, const std::string& name = "");
-        listener_handle subscribe_once(invocable&& listener, const std::string& name = "");
+        EventInterface(const EventInterface&) = delete;
+        EventInterface(EventInterface&&) = delete;
+        EventInterface& operator=(const EventInterface&) = delete;
+        EventInterface& operator=(EventInterface&&) = delete;
 
+        listener_handle subscribe(invocable&& listener);
+
+        // The listener is invoked at most once, even if the event is invoked from several threads at the same time
+        listener_handle subscribe_once(invocable&& listener);
+
+        // Unsubscribing is constant time, and does nothing if the listener was already removed
         void unsubscribe(listener_handle handle);
-        void unsubscribe(const std::string& name);
 
-        static constexpr listener_handle null_handle = -1;
+        static constexpr listener_handle null_handle = std::numeric_limits<listener_handle>::max();
 
     protected:
         EventInterface() = default;
+        ~EventInterface();
+
+        struct Listener
+        {
+            invocable listener;
+            std::atomic<bool> active = false;
+            bool once = false;
+            uint32_t generation = 0;
+        };
+
+        // Chunks double in size so that a fixed number of them can hold any number of listeners
+        static constexpr uint32_t first_chunk_size = 8;
+        static constexpr uint32_t max_chunks = 24;
+
+        [[nodiscard]] static uint32_t chunk_of(uint32_t index) noexcept;
+        [[nodiscard]] static uint32_t chunk_start(uint32_t chunk) noexcept;
+        [[nodiscard]] Listener& listener_at(uint32_t index) const noexcept;
+
+        listener_handle subscribe(invocable&& listener, bool once);
 
-        void subscribe(invocable&& listener, const std::string& name, listener_handle handle);
-        void process_pending_actions();
+        // Must be called with the mutex held, once the listener has been deactivated
+        void retire(uint32_t index);
+        void reclaim_retired();
 
-        listener_handle get_new_handle();
+        void begin_invoke() noexcept;
+        void end_invoke();
 
-        listener_handle _next_handle = 0;
-        std::vector<named_listener> _listeners;
-        std::vector<std::function<void()>> _pending_actions;
-        bool _is_invoking = false;
+        std::array<std::atomic<Listener*>, max_chunks> _chunks = {};
+        std::atomic<uint32_t> _num_listeners = 0;
+        std::atomic<int32_t> _num_invoking = 0;
+
+        std::mutex _mutex;
+        std::vector<uint32_t> _free_listeners;
+        std::vector<uint32_t> _retired_listeners;
     };
 
     template <typename...Args>
@@ -45,125 +82,197 @@ namespace utils
     {
     public:
         using invocable = EventInterface<Args...>::invocable;
-        using named_listener = EventInterface<Args...>::named_listener;
+
+        Event() = default;
 
         void invoke(Args...args);
         void operator()(Args...args);
     };
 
     template <typename...Args>
-    EventInterface<Args...>::listener_handle EventInterface<Args...>::subscribe(invocable&& listener, const std::string& name)
+    EventInterface<Args...>::~EventInterface()
     {
-        listener_handle handle = get_new_handle();
-        subscribe(std::move(listener), name, handle);
+        check(_num_invoking == 0);
 
-        return handle;
+        for (std::atomic<Listener*>& chunk : _chunks)
+        {
+            delete[] chunk.load(std::memory_order_relaxed);
+        }
     }
 
-    template <typename ... Args>
-    typename EventInterface<Args...>::listener_handle EventInterface<Args...>::subscribe_once(invocable&& listener,
-        const std::string& name)
+    template <typename...Args>
+    EventInterface<Args...>::listener_handle EventInterface<Args...>::subscribe(invocable&& listener)
     {
-        listener_handle handle = get_new_handle();
-        invocable listener_once = [inner = std::move(listener), handle, this](Args...args)
-        {
-            inner(std::forward<Args...>(args)...);
-            unsubscribe(handle);
-        };
+        return subscribe(std::move(listener), false);
+    }
 
-        subscribe(std::move(listener_once), name, handle);
-        return handle;
+    template <typename...Args>
+    EventInterface<Args...>::listener_handle EventInterface<Args...>::subscribe_once(invocable&& listener)
+    {
+        return subscribe(std::move(listener), true);
     }
 
     template <typename...Args>
-    void EventInterface<Args...>::subscribe(invocable&& listener, const std::string& name, listener_handle handle)
+    EventInterface<Args...>::listener_handle EventInterface<Args...>::subscribe(invocable&& listener, bool once)
     {
-        if (_is_invoking)
+        std::lock_guard lock(_mutex);
+        reclaim_retired();
+
+        uint32_t index;
+        const bool reused = !_free_listeners.empty();
+
+        if (reused)
         {
-            _pending_actions.push_back([this, listener = std::move(listener), name, handle]() mutable {
-                subscribe(std::move(listener), name, handle);
-            });
+            index = _free_listeners.back();
+            _free_listeners.pop_back();
         }
         else
         {
+            index = _num_listeners.load(std::memory_order_relaxed);
+
+            const uint32_t chunk = chunk_of(index);
+            check(chunk < max_chunks);
 
-            _listeners.push_back(named_listener(std::move(listener), name, handle));
+            if (!_chunks[chunk].load(std::memory_order_relaxed))
+            {
+                _chunks[chunk].store(new Listener[first_chunk_size << chunk], std::memory_order_release);
+            }
         }
+
+        // Invocations only read a listener once it's active, which publishes everything written before it
+        Listener& entry = listener_at(index);
+        entry.listener = std::move(listener);
+        entry.once = once;
+        entry.active.store(true, std::memory_order_release);
+
+        if (!reused)
+        {
+            _num_listeners.store(index + 1, std::memory_order_release);
+        }
+
+        return (static_cast<listener_handle>(entry.generation) << 32) | index;
     }
 
     template <typename...Args>
     void EventInterface<Args...>::unsubscribe(listener_handle handle)
     {
-        if (_is_invoking)
+        const uint32_t index = static_cast<uint32_t>(handle);
+        const uint32_t generation = static_cast<uint32_t>(handle >> 32);
+
+        std::lock_guard lock(_mutex);
+        if (handle == null_handle || index >= _num_listeners.load(std::memory_order_relaxed))
         {
-            _pending_actions.push_back([this, handle] {
-                unsubscribe(handle);
-            });
+            return;
         }
-        else
+
+        // Once listeners that have already fired were deactivated, and retired, by the invocation that fired them
+        Listener& entry = listener_at(index);
+        if (entry.generation == generation && entry.active.exchange(false))
         {
-            vectools::remove_all<named_listener>(_listeners, [&](const named_listener& listener)
-            {
-                return std::get<listener_handle>(listener) == handle;
-            });
+            retire(index);
         }
     }
 
     template <typename...Args>
-    void EventInterface<Args...>::unsubscribe(const std::string& name)
+    uint32_t EventInterface<Args...>::chunk_of(uint32_t index) noexcept
+    {
+        return static_cast<uint32_t>(std::bit_width(index / first_chunk_size + 1)) - 1;
+    }
+
+    template <typename...Args>
+    uint32_t EventInterface<Args...>::chunk_start(uint32_t chunk) noexcept
+    {
+        return first_chunk_size * ((1u << chunk) - 1);
+    }
+
+    template <typename...Args>
+    EventInterface<Args...>::Listener& EventInterface<Args...>::listener_at(uint32_t index) const noexcept
+    {
+        const uint32_t chunk = chunk_of(index);
+        return _chunks[chunk].load(std::memory_order_acquire)[index - chunk_start(chunk)];
+    }
+
+    template <typename...Args>
+    void EventInterface<Args...>::retire(uint32_t index)
+    {
+        _retired_listeners.push_back(index);
+        reclaim_retired();
+    }
+
+    template <typename...Args>
+    void EventInterface<Args...>::reclaim_retired()
     {
-        if (_is_invoking)
+        // Invocations that start from here on will never see a retired listener as active, but ones already
+        // in progress may still be calling them
+        if (_retired_listeners.empty() || _num_invoking.load() != 0)
         {
-            _pending_actions.push_back([this, name] {
-                unsubscribe(name);
-            });
+            return;
         }
-        else
+
+        for (const uint32_t index : _retired_listeners)
         {
-            vectools::remove_all<named_listener>(_listeners, [&](const named_listener& listener)
-            {
-                return std::get<std::string>(listener) == name;
-            });
+            Listener& entry = listener_at(index);
+            entry.listener.reset();
+            entry.generation++;
+
+            _free_listeners.push_back(index);
         }
+
+        _retired_listeners.clear();
     }
 
     template <typename...Args>
-    EventInterface<Args...>::listener_handle EventInterface<Args...>::get_new_handle()
+    void EventInterface<Args...>::begin_invoke() noexcept
     {
-        return _next_handle++;
+        _num_invoking.fetch_add(1);
     }
 
     template <typename...Args>
-    void EventInterface<Args...>::process_pending_actions()
+    void EventInterface<Args...>::end_invoke()
     {
-        check(!_is_invoking);
-
-        for (const std::function<void()>& action : _pending_actions)
+        if (_num_invoking.fetch_sub(1) == 1)
         {
-            action();
+            std::lock_guard lock(_mutex);
+            reclaim_retired();
         }
-
-        _pending_actions.clear();
     }
 
     template <typename...Args>
     void Event<Args...>::invoke(Args...args)
     {
-        this->_is_invoking = true;
+        using Listener = EventInterface<Args...>::Listener;
+
+        this->begin_invoke();
 
-        for (const named_listener& listener : this->_listeners)
+        const uint32_t num_listeners = this->_num_listeners.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < num_listeners; i++)
         {
-            std::get<invocable>(listener)(std::forward<Args...>(args)...);
+            Listener& entry = this->listener_at(i);
+            if (!entry.active.load())
+            {
+                continue;
+            }
+
+            if (!entry.once)
+            {
+                entry.listener(args...);
+            }
+            else if (entry.active.exchange(false))
+            {
+                entry.listener(args...);
+
+                std::lock_guard lock(this->_mutex);
+                this->retire(i);
+            }
         }
 
-        this->_is_invoking = false;
-        this->process_pending_actions();
+        this->end_invoke();
     }
 
     template <typename...Args>
     void Event<Args...>::operator()(Args...args)
     {
-        invoke(std::forward<Args...>(args)...);
+        invoke(args...);
     }
 }
 
@@ -171,4 +280,4 @@ namespace utils
 public: \
     utils::EventInterface<__VA_ARGS__>& name() noexcept { return _##name; } \
 private: \
-    utils::Event<__VA_ARGS__> _##name;
\ No newline at end of file
+    utils::Event<__VA_ARGS__> _##name;
@@ -0,0 +1,311 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+
+#include "check.h"
+
+namespace utils
+{
+    // A hierarchical timer wheel with constant time scheduling and cancellation of timers at integer ticks
+    // Each level has 256 slots, with a level's slot spanning a full revolution of the level below it
+    // Timers are held in the lowest level that covers their tick, and cascade down a level each time the wheel
+    // below them wraps around, so advancing only ever touches timers that are close to being due
+    template <typename T>
+    class HierarchicalTimerWheel
+    {
+    public:
+        struct Handle
+        {
+            uint32_t index;
+            uint32_t generation;
+        };
+
+        static constexpr Handle null_handle = { UINT32_MAX, 0 };
+
+        HierarchicalTimerWheel();
+
+        // Schedules value for an absolute tick, which fires on the next advance if it isn't after the current tick
+        Handle schedule(uint64_t tick, T&& value);
+
+        // Returns false if the timer already fired or was cancelled
+        bool cancel(Handle handle);
+
+        [[nodiscard]] bool pending(Handle handle) const noexcept;
+
+        // Advances the wheel to tick, invoking f(T&) for every timer that is due in the order of their ticks
+        // Timers may be scheduled and cancelled from within f, with new timers that are already due firing on the next advance
+        template <typename F>
+        void advance(uint64_t tick, F&& f);
+
+        void clear();
+
+        [[nodiscard]] size_t size() const noexcept { return _size; }
+        [[nodiscard]] uint64_t current_tick() const noexcept { return _current_tick; }
+
+    private:
+        static constexpr uint32_t slot_bits = 8;
+        static constexpr uint32_t num_slots = 1 << slot_bits;
+        static constexpr uint32_t num_levels = 4;
+        static constexpr uint32_t null_index = UINT32_MAX;
+
+        // Nodes not linked into a slot are either free or due to fire during the current advance
+        static constexpr int32_t free_slot = -1;
+        static constexpr int32_t due_slot = -2;
+
+        struct Node
+        {
+            T value;
+            uint64_t tick;
+            uint32_t prev;
+            uint32_t next;
+            uint32_t generation;
+            int32_t slot;
+        };
+
+        [[nodiscard]] int32_t slot_of(uint64_t tick) const noexcept;
+
+        void link(uint32_t index);
+        void unlink(uint32_t index);
+        void release(uint32_t index);
+        void cascade(uint32_t level);
+
+        std::vector<Node> _nodes;
+        std::vector<uint32_t> _free_nodes;
+        std::array<uint32_t, num_levels * num_slots> _slots;
+        std::vector<Handle> _due;
+
+        uint64_t _current_tick;
+        size_t _size;
+        bool _advancing;
+    };
+
+    template <typename T>
+    HierarchicalTimerWheel<T>::HierarchicalTimerWheel()
+        : _current_tick(0)
+        , _size(0)
+        , _advancing(false)
+    {
+        _slots.fill(null_index);
+    }
+
+    template <typename T>
+    typename HierarchicalTimerWheel<T>::Handle HierarchicalTimerWheel<T>::schedule(uint64_t tick, T&& value)
+    {
+        uint32_t index;
+        if (!_free_nodes.empty())
+        {
+            index = _free_nodes.back();
+            _free_nodes.pop_back();
+            _nodes[index].value = std::move(value);
+        }
+        else
+        {
+            index = static_cast<uint32_t>(_nodes.size());
+            _nodes.push_back({ std::move(value), 0, null_index, null_index, 0, free_slot });
+        }
+
+        // Ticks that have already been passed are treated as due on the next tick
+        _nodes[index].tick = std::max(tick, _current_tick + 1);
+        link(index);
+        _size++;
+
+        return { index, _nodes[index].generation };
+    }
+
+    template <typename T>
+    bool HierarchicalTimerWheel<T>::cancel(Handle handle)
+    {
+        if (!pending(handle))
+        {
+            return false;
+        }
+
+        // Due timers are left in the due list, which skips them once their generation has moved on
+        if (_nodes[handle.index].slot != due_slot)
+        {
+            unlink(handle.index);
+        }
+
+        release(handle.index);
+        _size--;
+
+        return true;
+    }
+
+    template <typename T>
+    bool HierarchicalTimerWheel<T>::pending(Handle handle) const noexcept
+    {
+        return handle.index < _nodes.size()
+            && _nodes[handle.index].generation == handle.generation
+            && _nodes[handle.index].slot != free_slot;
+    }
+
+    template <typename T>
+    template <typename F>
+    void HierarchicalTimerWheel<T>::advance(uint64_t tick, F&& f)
+    {
+        check(!_advancing);
+        check(tick >= _current_tick);
+
+        // Nothing can fire on an empty wheel so there's no need to step through each tick
+        if (_size == 0)
+        {
+            _current_tick = tick;
+            return;
+        }
+
+        _advancing = true;
+
+        while (_current_tick < tick && _due.size() < _size)
+        {
+            _current_tick++;
+
+            // Higher levels cascade first so that their timers can carry on down through the levels below
+            for (uint32_t level = num_levels - 1; level > 0; level--)
+            {
+                const uint64_t level_mask = (uint64_t(1) << (slot_bits * level)) - 1;
+                if ((_current_tick & level_mask) == 0)
+                {
+                    cascade(level);
+                }
+            }
+
+            const uint32_t slot = static_cast<uint32_t>(_current_tick & (num_slots - 1));
+            while (_slots[slot] != null_index)
+            {
+                const uint32_t index = _slots[slot];
+                unlink(index);
+
+                _nodes[index].slot = due_slot;
+                _due.push_back({ index, _nodes[index].generation });
+            }
+        }
+
+        _current_tick = tick;
+
+        // Due timers are released before they fire so that they can schedule new timers into the nodes they free
+        for (size_t i = 0; i < _due.size(); i++)
+        {
+            const Handle handle = _due[i];
+            if (!pending(handle))
+            {
+                continue;
+            }
+
+            T value = std::move(_nodes[handle.index].value);
+            release(handle.index);
+            _size--;
+
+            f(value);
+        }
+
+        _due.clear();
+        _advancing = false;
+    }
+
+    template <typename T>
+    void HierarchicalTimerWheel<T>::clear()
+    {
+        check(!_advancing);
+
+        for (uint32_t i = 0; i < _nodes.size(); i++)
+        {
+            if (_nodes[i].slot != free_slot)
+            {
+                release(i);
+            }
+        }
+
+        _slots.fill(null_index);
+        _size = 0;
+    }
+
+    template <typename T>
+    int32_t HierarchicalTimerWheel<T>::slot_of(uint64_t tick) const noexcept
+    {
+        // A timer belongs to the lowest level whose revolution it shares with the current tick
+        for (uint32_t level = 0; level < num_levels; level++)
+        {
+            const uint32_t shift = slot_bits * (level + 1);
+            if ((tick >> shift) == (_current_tick >> shift))
+            {
+                const uint32_t slot = static_cast<uint32_t>((tick >> (slot_bits * level)) & (num_slots - 1));
+                return static_cast<int32_t>(level * num_slots + slot);
+            }
+        }
+
+        // Timers beyond the top level wait in the last slot to cascade, and are placed again once it does
+        const uint32_t top_shift = slot_bits * (num_levels - 1);
+        const uint32_t slot = static_cast<uint32_t>(((_current_tick >> top_shift) - 1) & (num_slots - 1));
+        return static_cast<int32_t>((num_levels - 1) * num_slots + slot);
+    }
+
+    template <typename T>
+    void HierarchicalTimerWheel<T>::link(uint32_t index)
+    {
+        Node& node = _nodes[index];
+        node.slot = slot_of(node.tick);
+        node.prev = null_index;
+        node.next = _slots[node.slot];
+
+        if (node.next != null_index)
+        {
+            _nodes[node.next].prev = index;
+        }
+
+        _slots[node.slot] = index;
+    }
+
+    template <typename T>
+    void HierarchicalTimerWheel<T>::unlink(uint32_t index)
+    {
+        Node& node = _nodes[index];
+        check(node.slot >= 0);
+
+        if (node.prev != null_index)
+        {
+            _nodes[node.prev].next = node.next;
+        }
+        else
+        {
+            _slots[node.slot] = node.next;
+        }
+
+        if (node.next != null_index)
+        {
+            _nodes[node.next].prev = node.prev;
+        }
+
+        node.prev = null_index;
+        node.next = null_index;
+    }
+
+    template <typename T>
+    void HierarchicalTimerWheel<T>::release(uint32_t index)
+    {
+        Node& node = _nodes[index];
+        node.value = T();
+        node.slot = free_slot;
+        node.generation++;
+
+        _free_nodes.push_back(index);
+    }
+
+    template <typename T>
+    void HierarchicalTimerWheel<T>::cascade(uint32_t level)
+    {
+        const uint32_t slot = static_cast<uint32_t>((_current_tick >> (slot_bits * level)) & (num_slots - 1));
+        uint32_t index = std::exchange(_slots[level * num_slots + slot], null_index);
+
+        while (index != null_index)
+        {
+            const uint32_t next = _nodes[index].next;
+            link(index);
+            index = next;
+        }
+    }
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+#include "check.h"
+
+namespace utils
+{
+    // A hashed timer wheel for scheduling large numbers of timers with constant time insertion
+    // Time is divided into ticks of a fixed resolution, and each slot holds the timers due on every num_slots-th tick
+    // Advancing only visits the slots of the ticks that have passed, so timers far in the future are rarely touched
+    template <typename T>
+    class TimerWheel
+    {
+    public:
+        explicit TimerWheel(double resolution = 1.0 / 120.0, size_t num_slots = 512);
+
+        // Schedules value to fire at an absolute time, which fires on the next advance if it has already passed
+        void schedule(double time, const T& value);
+
+        // Advances the wheel to time, invoking f(value) for every timer that is due in no particular order
+        // Timers may safely be scheduled from within f
+        template <typename F>
+        void advance(double time, F&& f);
+
+        void clear();
+
+        [[nodiscard]] size_t size() const noexcept { return _size; }
+        [[nodiscard]] double time() const noexcept { return _time; }
+
+    private:
+        struct Timer
+        {
+            double time;
+            T value;
+        };
+
+        [[nodiscard]] int64_t tick_of(double time) const noexcept;
+
+        double _resolution;
+        std::vector<std::vector<Timer>> _slots;
+        std::vector<T> _due;
+        int64_t _current_tick;
+        double _time;
+        size_t _size;
+    };
+
+    template <typename T>
+    TimerWheel<T>::TimerWheel(double resolution, size_t num_slots)
+        : _resolution(resolution)
+        , _slots(num_slots)
+        , _current_tick(0)
+        , _time(0)
+        , _size(0)
+    {
+        check(resolution > 0);
+        check(num_slots > 0);
+    }
+
+    template <typename T>
+    void TimerWheel<T>::schedule(double time, const T& value)
+    {
+        const int64_t tick = std::max(tick_of(time), _current_tick);
+        _slots[tick % _slots.size()].push_back({ time, value });
+        _size++;
+    }
+
+    template <typename T>
+    template <typename F>
+    void TimerWheel<T>::advance(double time, F&& f)
+    {
+        check(time >= _time);
+
+        const int64_t target_tick = tick_of(time);
+        const int64_t num_ticks = std::min<int64_t>(target_tick - _current_tick + 1, _slots.size());
+
+        _time = time;
+
+        // Slots hold timers from later revolutions too, which are left in place
+        for (int64_t i = 0; i < num_ticks; i++)
+        {
+            std::vector<Timer>& slot = _slots[(_current_tick + i) % _slots.size()];
+            for (size_t j = 0; j < slot.size();)
+            {
+                if (slot[j].time <= time)
+                {
+                    _due.push_back(std::move(slot[j].value));
+                    slot[j] = std::move(slot.back());
+                    slot.pop_back();
+                }
+                else
+                {
+                    j++;
+                }
+            }
+        }
+
+        _current_tick = target_tick;
+        _size -= _due.size();
+
+        // Due timers are collected first so that f can schedule new timers without invalidating the slots
+        std::vector<T> due;
+        std::swap(due, _due);
+
+        for (const T& value : due)
+        {
+            f(value);
+        }
+
+        due.clear();
+        std::swap(due, _due);
+    }
+
+    template <typename T>
+    void TimerWheel<T>::clear()
+    {
+        for (std::vector<Timer>& slot : _slots)
+        {
+            slot.clear();
+        }
+
+        _due.clear();
+        _size = 0;
+    }
+
+    template <typename T>
+    int64_t TimerWheel<T>::tick_of(double time) const noexcept
+    {
+        return static_cast<int64_t>(std::floor(time / _resolution));
+    }
+}
@@ -33,8 +33,8 @@ namespace vectools
         return v.size() * sizeof(T);
     }
 
-    template <typename T>
-    T* try_back(std::vector<T>& v)
+    template <typename T, typename Allocator>
+    T* try_back(std::vector<T, Allocator>& v)
     {
         if (v.empty())
         {